@@ -0,0 +1,58 @@
+/*
+ * Paravirtual console for Linux guests of the hypervisor.
+ *
+ * Kernel messages are handed to the hypervisor a whole buffer at a time, with the SVC #0xC0
+ * hypercall (R0 = buffer, R1 = length, R0 returns the bytes written), instead of one trapped UART
+ * register write per character.
+ * The hypervisor must be built with CONFIG_PARAVIRT_CONSOLE; SVC #0xC0 in kernel mode is a fatal
+ * error for older builds.
+ */
+#include <linux/console.h>
+#include <linux/init.h>
+#include <linux/kernel.h>
+#include <linux/module.h>
+
+#define HYPERCALL_CONSOLE_WRITE "0xc0"
+
+static void hyparm_console_write(struct console *con, const char *s, unsigned count)
+{
+	while (count > 0) {
+		register const char *r0 asm("r0") = s;
+		register unsigned r1 asm("r1") = count;
+
+		asm volatile("swi	#" HYPERCALL_CONSOLE_WRITE
+			     : "+r" (r0)
+			     : "r" (r1)
+			     : "memory", "cc");
+
+		/* the hypervisor takes at most a page per call, and nothing it cannot read */
+		if ((unsigned)r0 == 0)
+			break;
+		s += (unsigned)r0;
+		count -= (unsigned)r0;
+	}
+}
+
+static struct console hyparm_console = {
+	.name	= "hyp",
+	.write	= hyparm_console_write,
+	.flags	= CON_PRINTBUFFER | CON_ENABLED,
+	.index	= -1,
+};
+
+static int __init hyparm_console_init(void)
+{
+	register_console(&hyparm_console);
+	return 0;
+}
+
+static void __exit hyparm_console_exit(void)
+{
+	unregister_console(&hyparm_console);
+}
+
+console_initcall(hyparm_console_init);
+module_exit(hyparm_console_exit);
+
+MODULE_DESCRIPTION("Hypervisor paravirtual console");
+MODULE_LICENSE("GPL");
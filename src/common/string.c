@@ -6,40 +6,45 @@ void *memcpy(void *destination, const void *source, u32int count)
 {
   const char *src = (const char *)source;
   char *dst = (char *)destination;
-  u32int i;
 
-  if (!((u32int)source & 0xC) && !((u32int)destination & 0xC))
+  if (!(((u32int)src ^ (u32int)dst) & 3))
   {
-    /* Word aligned so we can safely do word copies */
-    for (i = 0; i < count; i += 4)
+    /* Same alignment: copy the unaligned head by bytes, then cache lines and words */
+    while (((u32int)dst & 3) && count)
     {
-      if (i + 3 > count - 1)
-      {
-        /* Don't copy too much */
-        break;
-      }
-
-      *(u32int *)dst = *(const u32int *)src;
-      dst += 4;
-      src += 4;
+      *dst++ = *src++;
+      count--;
     }
-    if (i < count - 1)
+
+    const u32int *wordSrc = (const u32int *)src;
+    u32int *wordDst = (u32int *)dst;
+    while (count >= 32)
     {
-      for (; i < count; i++)
-      {
-        *dst = *src;
-        dst++;
-        src++;
-      }
+      wordDst[0] = wordSrc[0];
+      wordDst[1] = wordSrc[1];
+      wordDst[2] = wordSrc[2];
+      wordDst[3] = wordSrc[3];
+      wordDst[4] = wordSrc[4];
+      wordDst[5] = wordSrc[5];
+      wordDst[6] = wordSrc[6];
+      wordDst[7] = wordSrc[7];
+      wordDst += 8;
+      wordSrc += 8;
+      count -= 32;
     }
-  }
-  else
-  {
-    /* Generic version */
-    for (i = 0; i < count; i++)
+    while (count >= 4)
     {
-      dst[i] = src[i];
+      *wordDst++ = *wordSrc++;
+      count -= 4;
     }
+    src = (const char *)wordSrc;
+    dst = (char *)wordDst;
+  }
+
+  /* Unaligned tail, or pointers that can never be aligned to each other */
+  while (count--)
+  {
+    *dst++ = *src++;
   }
   return destination;
 }
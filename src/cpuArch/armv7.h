@@ -96,6 +96,62 @@ void l2_cache_disable(void);
     __asm__ __volatile__ ("CPSID f"); \
   }
 
+/*
+ * waitForInterrupt: sleep until an interrupt is pending, whether it is masked or not
+ */
+#define waitForInterrupt() \
+  { \
+    __asm__ __volatile__ ("WFI" : : : "memory"); \
+  }
+
+/*
+ * enableCycleCounter: start the cycle counter (PMCCNTR) without resetting it or touching the other
+ * performance counters. With CONFIG_STATS, callKernel sets the divider, and it counts every 64th
+ * cycle instead.
+ * readCycleCounter: current value of the cycle counter
+ */
+#define enableCycleCounter() \
+  { \
+    u32int pmnc; \
+    __asm__ __volatile__ ("MRC p15, 0, %0, c9, c12, 0" : "=r"(pmnc)); \
+    __asm__ __volatile__ ("MCR p15, 0, %0, c9, c12, 0" : : "r"(pmnc | 1)); \
+    __asm__ __volatile__ ("MCR p15, 0, %0, c9, c12, 1" : : "r"(1 << 31)); \
+  }
+
+static inline u32int readCycleCounter(void)
+{
+  u32int value;
+  __asm__ __volatile__ ("MRC p15, 0, %0, c9, c13, 0" : "=r"(value));
+  return value;
+}
+
+/*
+ * enableUserSoftwareCounter: reset a performance monitor event counter and make it count software
+ * increments, i.e. writes of (1 << counter) to PMSWINC. Enables user mode access to the performance
+ * monitors, so that translated code can increment it. With CONFIG_STATS, callKernel reprograms
+ * all four event counters.
+ * readEventCounter: current value of a performance monitor event counter
+ */
+#define enableUserSoftwareCounter(counter) \
+  { \
+    u32int pmnc; \
+    __asm__ __volatile__ ("MCR p15, 0, %0, c9, c12, 5" : : "r"(counter)); \
+    __asm__ __volatile__ ("MCR p15, 0, %0, c9, c13, 1" : : "r"(0)); \
+    __asm__ __volatile__ ("MCR p15, 0, %0, c9, c13, 2" : : "r"(0)); \
+    __asm__ __volatile__ ("MRC p15, 0, %0, c9, c12, 0" : "=r"(pmnc)); \
+    __asm__ __volatile__ ("MCR p15, 0, %0, c9, c12, 0" : : "r"(pmnc | 1)); \
+    __asm__ __volatile__ ("MCR p15, 0, %0, c9, c12, 1" : : "r"(1 << (counter))); \
+    __asm__ __volatile__ ("MCR p15, 0, %0, c9, c14, 0" : : "r"(1)); \
+  }
+
+static inline u32int readEventCounter(u32int counter)
+{
+  u32int value;
+  __asm__ __volatile__ ("MCR p15, 0, %0, c9, c12, 5" : : "r"(counter));
+  __asm__ __volatile__ ("MRC p15, 0, %0, c9, c13, 2" : "=r"(value));
+  return value;
+}
+
 /*
  * breakIfDebugging: insert software breakpoint when CONFIG_BKPT is set
  * infiniteIdleLoop: infinite loop waiting for interrupts (even if they are masked); used on crash
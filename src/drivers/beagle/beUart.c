@@ -17,11 +17,27 @@ struct UartBackEnd
 
 static struct UartBackEnd *beUart[3];
 
+#ifdef CONFIG_UART_TX_BUFFER
+/*
+ * output queued by serialPutcAsync(). it is written to the console UART from its THR interrupt,
+ * one character per interrupt as the FIFOs are disabled. head and tail only ever increase.
+ */
+#define SERIAL_TX_RING_SIZE  4096
+
+static u8int serialTxRing[SERIAL_TX_RING_SIZE];
+static u32int serialTxHead = 0;
+static u32int serialTxTail = 0;
+#endif
+
 
 static inline u32int beGetUartNumber(u32int phyAddr) __attribute__((always_inline));
 static inline u32int beGetUartBaseAddr(u32int id) __attribute__((always_inline));
 static inline u8int beLoadUart(u32int regOffs, u32int uartid) __attribute__((always_inline));
 static inline void beStoreUart(u32int regOffs, u8int value, u32int uartid) __attribute__((always_inline));
+#ifdef CONFIG_UART_TX_BUFFER
+static void serialFlushOutput(void);
+static void serialSetTxInterrupt(bool enable);
+#endif
 
 
 void serialPuts(const char *c)
@@ -36,6 +52,10 @@ void serialPuts(const char *c)
 
 void serialPutc(char c)
 {
+#ifdef CONFIG_UART_TX_BUFFER
+  // keep hypervisor output in order with buffered guest output
+  serialFlushOutput();
+#endif
   while ((beLoadUart(UART_LSR_REG, 3) & UART_LSR_TX_FIFO_E) == 0)
   {
     // do nothing
@@ -43,6 +63,101 @@ void serialPutc(char c)
   beStoreUart(UART_THR_REG, (u8int)c, 3);
 }
 
+#ifdef CONFIG_UART_TX_BUFFER
+/*
+ * queues a character for the console UART without waiting for the line.
+ * only waits if the TX ring is full.
+ */
+void serialPutcAsync(char c)
+{
+  if (serialTxHead == serialTxTail)
+  {
+    if ((beLoadUart(UART_LSR_REG, 3) & UART_LSR_TX_FIFO_E) != 0)
+    {
+      beStoreUart(UART_THR_REG, (u8int)c, 3);
+      return;
+    }
+    serialSetTxInterrupt(TRUE);
+  }
+
+  while ((serialTxHead - serialTxTail) == SERIAL_TX_RING_SIZE)
+  {
+    while ((beLoadUart(UART_LSR_REG, 3) & UART_LSR_TX_FIFO_E) == 0)
+    {
+      // do nothing
+    }
+    beStoreUart(UART_THR_REG, serialTxRing[serialTxTail % SERIAL_TX_RING_SIZE], 3);
+    serialTxTail++;
+  }
+
+  serialTxRing[serialTxHead % SERIAL_TX_RING_SIZE] = (u8int)c;
+  serialTxHead++;
+}
+
+/*
+ * called on the console UART interrupt: refills THR from the TX ring
+ */
+void serialDrainOutput()
+{
+  if (serialTxHead == serialTxTail)
+  {
+    return;
+  }
+  while ((serialTxHead != serialTxTail)
+         && ((beLoadUart(UART_LSR_REG, 3) & UART_LSR_TX_FIFO_E) != 0))
+  {
+    beStoreUart(UART_THR_REG, serialTxRing[serialTxTail % SERIAL_TX_RING_SIZE], 3);
+    serialTxTail++;
+  }
+  if (serialTxHead == serialTxTail)
+  {
+    serialSetTxInterrupt(FALSE);
+  }
+}
+
+u32int serialOutputPending()
+{
+  return serialTxHead - serialTxTail;
+}
+
+u32int serialOutputSpace()
+{
+  return SERIAL_TX_RING_SIZE - (serialTxHead - serialTxTail);
+}
+
+static void serialFlushOutput()
+{
+  if (serialTxHead == serialTxTail)
+  {
+    return;
+  }
+  while (serialTxHead != serialTxTail)
+  {
+    while ((beLoadUart(UART_LSR_REG, 3) & UART_LSR_TX_FIFO_E) == 0)
+    {
+      // do nothing
+    }
+    beStoreUart(UART_THR_REG, serialTxRing[serialTxTail % SERIAL_TX_RING_SIZE], 3);
+    serialTxTail++;
+  }
+  serialSetTxInterrupt(FALSE);
+}
+
+static void serialSetTxInterrupt(bool enable)
+{
+  u8int ier = beLoadUart(UART_IER_REG, 3);
+  if (enable)
+  {
+    ier |= UART_IER_THR;
+  }
+  else
+  {
+    ier &= ~UART_IER_THR;
+  }
+  beStoreUart(UART_IER_REG, ier, 3);
+}
+#endif /* CONFIG_UART_TX_BUFFER */
+
 char serialGetc()
 {
   while ((beLoadUart(UART_LSR_REG, 3) & UART_LSR_RX_FIFO_E) == 0)
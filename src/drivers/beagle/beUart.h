@@ -163,6 +163,16 @@ char serialGetcAsync(void);
 
 bool serialCheckInput(void);
 
+#ifdef CONFIG_UART_TX_BUFFER
+void serialPutcAsync(char c);
+
+void serialDrainOutput(void);
+
+u32int serialOutputPending(void);
+
+u32int serialOutputSpace(void);
+#endif
+
 void beUartInit(u32int uartid);
 
 void beUartReset(u32int uartid);
@@ -20,6 +20,7 @@
 #include "guestManager/scheduler.h"
 
 #include "instructionEmu/blockLinker.h"
+#include "instructionEmu/indirectBranchCache.h"
 #include "instructionEmu/loadStoreDecode.h"
 #include "instructionEmu/loopDetector.h"
 #include "instructionEmu/scanner.h"
@@ -65,6 +66,101 @@ static inline void resetLoopDetectorIfNeeded(GCONTXT *context)
 #define resetLoopDetectorIfNeeded(context)
 #endif /* CONFIG_LOOP_DETECTOR */
 
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+static inline void countInterruptDelivered(TranslationStore* ts);
+
+static inline void countInterruptDelivered(TranslationStore* ts)
+{
+  ts->interruptsDelivered++;
+}
+#else
+#define countInterruptDelivered(ts)
+#endif /* CONFIG_BLOCK_STORE_STATISTICS */
+
+#ifndef CONFIG_HW_PASSTHROUGH
+/*
+ * Physical IRQs are routed through a table indexed by their number. A passthrough route raises a
+ * guest IRQ line on the emulated interrupt controller, an emulate route hands the interrupt to an
+ * emulated device, and a drop route ignores it. The handler of a route, if any, runs after the
+ * guest IRQ is raised: it clears the interrupt at the source, or feeds the emulated device. The IRQ
+ * is acknowledged at the interrupt controller afterwards. IRQs without a route are fatal.
+ */
+enum irqRoutePolicy
+{
+  IRQ_ROUTE_NONE = 0,
+  IRQ_ROUTE_PASSTHROUGH,
+  IRQ_ROUTE_EMULATE,
+  IRQ_ROUTE_DROP
+};
+
+struct irqRoute
+{
+  enum irqRoutePolicy policy;
+  u32int guestIrq;
+  void (*handler)(GCONTXT *context);
+};
+
+static void gpt1Interrupt(GCONTXT *context);
+static void uart3Interrupt(GCONTXT *context);
+
+static const struct irqRoute irqRoutes[INTCPS_NR_OF_INTERRUPTS] =
+{
+  // gpt1 is dedicated to the guest.
+  [GPT1_IRQ]  = { .policy = IRQ_ROUTE_PASSTHROUGH, .guestIrq = GPT1_IRQ, .handler = gpt1Interrupt },
+  [UART3_IRQ] = { .policy = IRQ_ROUTE_EMULATE, .handler = uart3Interrupt }
+};
+
+static void gpt1Interrupt(GCONTXT *context)
+{
+  // FIXME: figure out which interrupt to clear and then clear the right one?
+  gptBEClearOverflowInterrupt(1);
+#ifdef CONFIG_GUEST_FREERTOS
+  if (context->os == GUEST_OS_FREERTOS)
+  {
+    gptBEResetCounter(1);
+    gptBEClearMatchInterrupt(1);
+  }
+#else
+  UNUSED(context);
+#endif
+}
+
+static void uart3Interrupt(GCONTXT *context)
+{
+#ifdef CONFIG_UART_TX_BUFFER
+  // THR empty: send more of the buffered guest output
+  serialDrainOutput();
+  uartTxSpaceAvailable(context);
+#endif
+  // read character from UART and forward it to the emulated UART
+  if (serialCheckInput())
+  {
+    uartPutRxByte(context, serialGetcAsync(), 3);
+  }
+}
+
+static const struct irqRoute *routeIrq(GCONTXT *context, u32int irqNumber)
+{
+  const struct irqRoute *route = irqNumber < INTCPS_NR_OF_INTERRUPTS ? &irqRoutes[irqNumber] : NULL;
+  if (route == NULL || route->policy == IRQ_ROUTE_NONE)
+  {
+    printf("Received IRQ = %#x" EOL, irqNumber);
+    DIE_NOW(context, ERROR_NOT_IMPLEMENTED);
+  }
+
+  if (route->policy == IRQ_ROUTE_PASSTHROUGH)
+  {
+    throwInterrupt(context, route->guestIrq);
+  }
+  if (route->handler != NULL)
+  {
+    route->handler(context);
+  }
+  acknowledgeIrqBE();
+  return route;
+}
+#endif /* CONFIG_HW_PASSTHROUGH */
+
 
 GCONTXT *softwareInterrupt(GCONTXT *context, u32int code)
 {
@@ -90,6 +186,9 @@ GCONTXT *softwareInterrupt(GCONTXT *context, u32int code)
   registerSvc(&(context->counters));
   DEBUG(EXCEPTION_HANDLERS, "softwareInterrupt(%x)" EOL, code);
 
+  // the block we came from may be at an interrupt safepoint; link it up again
+  clearInterruptSafepoint(context);
+
 #ifdef CONFIG_THUMB2
   /* Make sure that any SVC that is not part of the scanner
    * will be delivered to the guest */
@@ -148,6 +247,7 @@ GCONTXT *softwareInterrupt(GCONTXT *context, u32int code)
     if (context->CPSR.bits.I == 0)
     {
       deliverInterrupt(context);
+      countInterruptDelivered(context->translationStore);
       link = FALSE;
     }
   }
@@ -180,7 +280,14 @@ GCONTXT *softwareInterrupt(GCONTXT *context, u32int code)
       linkBlock(context, context->R15, lastTranslatedPC, block);
     }
 
-    scanBlock(context, context->R15);
+    BasicBlock* nextBlock = scanBlock(context, context->R15);
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+    if (link && !context->CPSR.bits.T && isIndirectBranchCacheable(endInstr))
+    {
+      // next time, the block will find its target without trapping
+      addIndirectBranchTarget(context->translationStore, nextBlock, endInstr);
+    }
+#endif
   }
   else
   {
@@ -422,15 +529,9 @@ GCONTXT *irq(GCONTXT *context)
 #ifdef CONFIG_HW_PASSTHROUGH
   if (isGuestInPrivMode(context))
   {
-    BasicBlock* block = getBasicBlockStoreEntry(context->translationStore, context->lastEntryBlockIndex);
-    // now we must unlink the current block if it is in a group block.
+    // make the current block trap at its end even if it is in a group block,
     // to make sure the guest isn't waiting for our deferred interrupt forever
-    if (block->type == GB_TYPE_ARM)
-    {
-      u32int index = findBlockIndexNumber(context, context->R15);
-      BasicBlock* groupblock = getBasicBlockStoreEntry(context->translationStore, index);
-      unlinkBlock(groupblock, index);
-    }
+    setInterruptSafepoint(context, findCurrentBlockIndex(context));
     // we defer until next hypercall
     context->guestIrqPending = TRUE;
     IrqBitModified = TRUE;
@@ -448,58 +549,14 @@ GCONTXT *irq(GCONTXT *context)
   }
 #else
   // Get the number of the highest priority active IRQ
-  u32int activeIrqNumber = getIrqNumberBE();
-  switch(activeIrqNumber)
+  const struct irqRoute *route = routeIrq(context, getIrqNumberBE());
+  if (route->policy == IRQ_ROUTE_PASSTHROUGH && isGuestInPrivMode(context))
   {
-    case GPT1_IRQ:
-    {
-      throwInterrupt(context, activeIrqNumber);
-      BasicBlock* block = getBasicBlockStoreEntry(context->translationStore, context->lastEntryBlockIndex);
-      // now we must unlink the current block if it is in a group block.
-      // to make sure the guest isn't waiting for our deferred interrupt forever
-      if (block->type == GB_TYPE_ARM)
-      {
-        u32int index = findBlockIndexNumber(context, context->R15);
-        BasicBlock* groupblock = getBasicBlockStoreEntry(context->translationStore, index);
-        unlinkBlock(groupblock, index);
-      }
- 
-      // FIXME: figure out which interrupt to clear and then clear the right one?
-      gptBEClearOverflowInterrupt(1);
-#ifdef CONFIG_GUEST_FREERTOS
-      if (context->os == GUEST_OS_FREERTOS)
-      {
-        gptBEResetCounter(1);
-        gptBEClearMatchInterrupt(1);
-      }
-#endif
-      acknowledgeIrqBE();
-      break;
-    }
-    case UART3_IRQ:
-    {
-      // read character from UART
-      if (serialCheckInput())
-      {
-        u8int c = serialGetcAsync();
-        acknowledgeIrqBE();
-        // forward character to emulated UART
-        uartPutRxByte(context, c, 3);
-      }
-      else
-      {
-        // what interrupt??
-        acknowledgeIrqBE();
-      }
-      break;
-    }
-    default:
-    {
-      printf("Received IRQ = %x" EOL, activeIrqNumber);
-      DIE_NOW(context, ERROR_NOT_IMPLEMENTED);
-    }
+    // make the current block trap at its end even if it is in a group block,
+    // to make sure the guest isn't waiting for our deferred interrupt forever
+    setInterruptSafepoint(context, findCurrentBlockIndex(context));
   }
- 
+
   /* Because the writes are posted on an Interconnect bus, to be sure
    * that the preceding writes are done before enabling IRQss,
    * a Data Synchronization Barrier is used. This operation ensure that
@@ -522,51 +579,8 @@ void irqPrivileged()
 #ifdef CONFIG_HW_PASSTHROUGH
   DIE_NOW(0, "irqPrivileged should not be here with HW passthrough.");
 #else
-  GCONTXT *const context = getActiveGuestContext();
   // Get the number of the highest priority active IRQ
-  u32int activeIrqNumber = getIrqNumberBE();
-  switch(activeIrqNumber)
-  {
-    case GPT1_IRQ:
-    {
-      throwInterrupt(context, activeIrqNumber);
-      /*
-       * FIXME: figure out which interrupt to clear and then clear the right one?
-       */
-      gptBEClearOverflowInterrupt(1);
-#ifdef CONFIG_GUEST_FREERTOS
-      if (context->os == GUEST_OS_FREERTOS)
-      {
-        gptBEResetCounter(1);
-        gptBEClearMatchInterrupt(1);
-      }
-#endif
-      acknowledgeIrqBE();
-      break;
-    }
-    case UART3_IRQ:
-    {
-      // read character from UART
-      if (serialCheckInput())
-      {
-        u8int c = serialGetcAsync();
-        acknowledgeIrqBE();
-        // forward character to emulated UART
-        uartPutRxByte(context, c, 3);
-      }
-      else
-      {
-        // what interrupt??
-        acknowledgeIrqBE();
-      }
-      break;
-    }
-    default:
-    {
-      printf("Received IRQ = %#x" EOL, activeIrqNumber);
-      DIE_NOW(NULL, ERROR_NOT_IMPLEMENTED);
-    }
-  }
+  routeIrq(getActiveGuestContext(), getIrqNumberBE());
 
   /* Because the writes are posted on an Interconnect bus, to be sure
    * that the preceding writes are done before enabling IRQss,
@@ -1,4 +1,5 @@
 #include "guestManager/basicBlockStore.h"
+#include "guestManager/codeStore.h"
 #include "guestManager/translationStore.h"
 #include "guestManager/guestContext.h"
 
@@ -7,51 +8,138 @@
 #include "common/linker.h"
 #include "common/stdlib.h"
 
+#include "instructionEmu/blockLinker.h"
+#include "instructionEmu/indirectBranchCache.h"
+
 #include "memoryManager/mmu.h"
 
 
+/*
+ * Multiplier for the Fibonacci hash of guest addresses: 2^32 divided by the golden ratio.
+ */
+#define BASIC_BLOCK_STORE_HASH_MULTIPLIER  0x9E3779B1U
+
+
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+static inline void countLookupProbes(TranslationStore* ts, u32int probes);
+static inline void countLookupHit(TranslationStore* ts, u32int probes);
+static inline void countLookupMiss(TranslationStore* ts, u32int probes);
+static inline void countEviction(TranslationStore* ts, bool groupBlock);
+
+static inline void countLookupProbes(TranslationStore* ts, u32int probes)
+{
+  ts->lookupProbes += probes;
+  if (probes > ts->lookupMaxProbes)
+  {
+    ts->lookupMaxProbes = probes;
+  }
+}
+
+static inline void countLookupHit(TranslationStore* ts, u32int probes)
+{
+  ts->lookupHits++;
+  countLookupProbes(ts, probes);
+}
+
+static inline void countLookupMiss(TranslationStore* ts, u32int probes)
+{
+  ts->lookupMisses++;
+  countLookupProbes(ts, probes);
+}
+
+static inline void countEviction(TranslationStore* ts, bool groupBlock)
+{
+  ts->evictions++;
+  if (groupBlock)
+  {
+    ts->groupEvictions++;
+  }
+}
+#else
+#define countLookupHit(ts, probes)
+#define countLookupMiss(ts, probes)
+#define countEviction(ts, groupBlock)
+#endif /* CONFIG_BLOCK_STORE_STATISTICS */
+
+
+/*
+ * Multiplicative hash of the word-aligned guest address. Unlike a plain (address >> 2) index it
+ * spreads the blocks of large, dense kernel text sections over the whole store, so that probe
+ * chains stay short.
+ */
 static inline u32int getBasicBlockStoreIndex(u32int startAddress)
 {
-  return (startAddress >> 2) & (BASIC_BLOCK_STORE_SIZE - 1);
+  return ((startAddress >> 2) * BASIC_BLOCK_STORE_HASH_MULTIPLIER) >> (32 - BASIC_BLOCK_STORE_BITS);
 }
 
 
+/*
+ * Looks up the block starting at startAddress. At most BASIC_BLOCK_STORE_PROBE_LIMIT entries
+ * starting from the home index of the address are examined. Because blocks can be invalidated in
+ * the middle of a probe window, the whole window is checked before giving up.
+ *
+ * If the block is not found, the returned entry is where a block for startAddress should be
+ * placed: the first free entry in the window if there is one, or otherwise the least recently used
+ * block in the window, preferring blocks that are not part of a group block. In the latter case the
+ * caller must evict the block with evictBlock() before reusing the entry.
+ */
 BlockInfo getBlockInfo(TranslationStore* ts, u32int startAddress)
 {
-  BlockInfo info = {.blockFound = FALSE, .blockIndex = 0};
-  u32int index = getBasicBlockStoreIndex(startAddress);
+  BlockInfo info = {.blockFound = FALSE, .blockIndex = 0, .blockPtr = NULL};
+  const u32int homeIndex = getBasicBlockStoreIndex(startAddress);
+  const u32int clock = ++ts->blockStoreClock;
 
-  BasicBlock* block;
+  bool freeFound = FALSE;
+  u32int victimIndex = homeIndex;
+  u32int victimAge = 0;
+  bool victimGrouped = TRUE;
 
-  do
+  u32int probe;
+  for (probe = 0; probe < BASIC_BLOCK_STORE_PROBE_LIMIT; probe++)
   {
-    block = &ts->basicBlockStore[index];
+    u32int index = (homeIndex + probe) & (BASIC_BLOCK_STORE_SIZE - 1);
+    BasicBlock* block = &ts->basicBlockStore[index];
     if (block->type == BB_TYPE_INVALID)
     {
-      // no block here
-      info.blockFound = FALSE;
+      // free entry; the block may still live further on in the window, so carry on.
+      if (!freeFound)
+      {
+        freeFound = TRUE;
+        info.blockIndex = index;
+        info.blockPtr = block;
+      }
+    }
+    else if ((u32int)block->guestStart == startAddress)
+    {
+      // found block here
+      block->lastUsed = clock;
+      countLookupHit(ts, probe + 1);
+      info.blockFound = TRUE;
       info.blockIndex = index;
       info.blockPtr = block;
       return info;
     }
-    else
+    else if (!freeFound)
     {
-      if ((u32int)block->guestStart == startAddress)
+      // some other block lives here; keep track of the best candidate for eviction.
+      bool grouped = (block->type == GB_TYPE_ARM);
+      u32int age = clock - block->lastUsed;
+      if ((victimGrouped && !grouped) || (victimGrouped == grouped && age >= victimAge))
       {
-        // found block here
-        info.blockFound = TRUE;
-        info.blockIndex = index;
-        info.blockPtr = block;
-        return info;
-      }
-      else
-      {
-        // some other block lives here, keep calm and carry on.
-        index++;
+        victimIndex = index;
+        victimAge = age;
+        victimGrouped = grouped;
       }
     }
-  } // really loop until block is found of placed.
-  while (TRUE);
+  }
+
+  countLookupMiss(ts, BASIC_BLOCK_STORE_PROBE_LIMIT);
+  if (!freeFound)
+  {
+    info.blockIndex = victimIndex;
+    info.blockPtr = &ts->basicBlockStore[victimIndex];
+  }
+  return info;
 }
 
 
@@ -75,45 +163,10 @@ void addInstructionToBlock(struct TranslationStore* ts, BasicBlock* basicBlock,
   }
   ts->codeStoreFreePtr++;
 
-  if ((u32int)ts->codeStoreFreePtr >= RAM_CODE_CACHE_POOL_END)
+  // rescans (with writes disabled) only revisit blocks placed within a single segment.
+  if (ts->write && ts->codeStoreFreePtr >= ts->codeStoreSegmentEnd)
   {
-    printf("reached the end of code cache pool!\n");
-    dumpBlockStoreStats(getActiveGuestContext());
-    // reset free pointer
-    ts->codeStoreFreePtr = ts->codeStore;
-
-    // copy instructions that have already been copied for this block to front of CS
-    u32int i = 0;
-    u32int* instrPtr = basicBlock->codeStoreStart;
-    for (i = 0; i < basicBlock->codeStoreSize; i++)
-    {
-      if (ts->write)
-      {
-        *ts->codeStoreFreePtr = *instrPtr;
-      }
-      ts->codeStoreFreePtr++;
-      instrPtr++;
-    }
-
-    if (ts->write)
-    {
-      basicBlock->codeStoreStart = ts->codeStore;
-
-      // save all information from basic block entry
-      // as basic block store is going to be zeroed
-      BasicBlock tempBlock = *basicBlock;
-
-      // invalidate the basic block store
-      memset(ts->basicBlockStore, 0, BASIC_BLOCK_STORE_SIZE * sizeof(BasicBlock));
-
-      // restore basic block store entry
-      basicBlock->guestStart = tempBlock.guestStart;
-      basicBlock->guestEnd = tempBlock.guestEnd;
-      basicBlock->codeStoreStart = tempBlock.codeStoreStart;
-      basicBlock->codeStoreSize = tempBlock.codeStoreSize;
-      basicBlock->handler = tempBlock.handler;
-      basicBlock->type = tempBlock.type;
-    }
+    startNextCodeStoreSegment(ts, basicBlock);
   }
 
   DEBUG(BLOCK_STORE, "addInstructionToBlock: codeStoreSize %x\n", basicBlock->codeStoreSize);
@@ -126,31 +179,139 @@ void invalidateBlock(BasicBlock* block)
   block->type = BB_TYPE_INVALID;
 }
 
-void setExecBitmap(GCONTXT* context, u32int start, u32int end)
+
+/*
+ * Removes a block from the block store to make room for a new one. The translated code of the
+ * block stays in the code store until its segment is retired, but must no longer be reachable.
+ */
+void evictBlock(TranslationStore* ts, BasicBlock* block, u32int index)
 {
-  // calculate which byte and bit in bitmap
-  u32int startingPage = start >> 12;
-  u32int endingPage = end >> 12;
-  u32int byteIndex = startingPage >> 3;
-  u32int bitIndex = startingPage - (byteIndex << 3);
-  u8int actualByte = context->execBitmap[byteIndex];
-  u8int actualBit = (actualByte >> bitIndex) & 1;
-  if (actualBit == 0)
+  DEBUG(BLOCK_STORE, "evictBlock: block %p index %x guestStart %p type %x" EOL,
+        block, index, block->guestStart, block->type);
+
+  bool groupBlock = (block->type == GB_TYPE_ARM);
+  // blocks branching into this one must trap into the hypervisor (with their own index) again.
+  unlinkRemovedBlock(getActiveGuestContext(), index);
+  countEviction(ts, groupBlock);
+  removeBlockFromPageIndex(ts, index);
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  removeIndirectBranchTarget(ts, block);
+#endif
+  invalidateBlock(block);
+}
+
+static inline u32int getPageIndexBucket(u32int page)
+{
+  return page & (BLOCK_PAGE_INDEX_SIZE - 1);
+}
+
+
+static inline struct BlockPageLink* getPageLink(TranslationStore* ts, u32int reference)
+{
+  BasicBlock* block = &ts->basicBlockStore[PAGE_LINK_BLOCK_INDEX(reference)];
+  return &block->pageLinks[PAGE_LINK_NUMBER(reference)];
+}
+
+
+static void insertPageLink(TranslationStore* ts, u32int page, u32int reference)
+{
+  u32int* head = &ts->pageIndex[getPageIndexBucket(page)];
+  struct BlockPageLink* link = getPageLink(ts, reference);
+  link->next = *head;
+  link->prev = BLOCK_INDEX_NONE;
+  if (*head != BLOCK_INDEX_NONE)
   {
-    context->execBitmap[byteIndex] = actualByte | (1 << bitIndex);
+    getPageLink(ts, *head)->prev = reference;
   }
+  *head = reference;
+}
+
 
-  if (startingPage != endingPage)
+static void removePageLink(TranslationStore* ts, u32int page, u32int reference)
+{
+  struct BlockPageLink* link = getPageLink(ts, reference);
+  if (link->prev == BLOCK_INDEX_NONE)
   {
-    // we span two sections. do another bit..
-    u32int byteIndexEnd = endingPage >> 3;
-    u32int bitIndexEnd = endingPage - (byteIndexEnd << 3);
-    u8int actualByteEnd = context->execBitmap[bitIndexEnd];
-    u8int actualBitEnd = (actualByteEnd >> bitIndexEnd) & 1;
-    if (actualBitEnd == 0)
-    {
-      context->execBitmap[byteIndexEnd] = actualByteEnd | (1 << bitIndexEnd);
-    }
+    ts->pageIndex[getPageIndexBucket(page)] = link->next;
+  }
+  else
+  {
+    getPageLink(ts, link->prev)->next = link->next;
+  }
+  if (link->next != BLOCK_INDEX_NONE)
+  {
+    getPageLink(ts, link->next)->prev = link->prev;
+  }
+}
+
+
+/*
+ * Adds a freshly scanned block to the page index, on the list of every page it overlaps.
+ */
+void addBlockToPageIndex(TranslationStore* ts, u32int index)
+{
+  BasicBlock* block = &ts->basicBlockStore[index];
+  u32int startPage = (u32int)block->guestStart >> 12;
+  u32int endPage = (u32int)block->guestEnd >> 12;
+  u32int link;
+
+  ASSERT(endPage - startPage < BLOCK_MAX_PAGES, "block spans too many pages");
+  for (link = 0; link <= endPage - startPage; link++)
+  {
+    insertPageLink(ts, startPage + link, PAGE_LINK_REFERENCE(index, link));
+  }
+}
+
+
+/*
+ * Removes a block from the page index. This must be done before the guest addresses of the block
+ * are overwritten.
+ */
+void removeBlockFromPageIndex(TranslationStore* ts, u32int index)
+{
+  BasicBlock* block = &ts->basicBlockStore[index];
+  u32int startPage = (u32int)block->guestStart >> 12;
+  u32int endPage = (u32int)block->guestEnd >> 12;
+  u32int link;
+
+  for (link = 0; link <= endPage - startPage; link++)
+  {
+    removePageLink(ts, startPage + link, PAGE_LINK_REFERENCE(index, link));
+  }
+}
+
+
+void clearPageIndex(TranslationStore* ts)
+{
+  memset(ts->pageIndex, 0xFF, BLOCK_PAGE_INDEX_SIZE * sizeof(u32int));
+}
+
+
+/*
+ * Page index iteration. The returned references must be decoded with PAGE_LINK_BLOCK_INDEX. The
+ * bucket of a page is shared with other pages, so callers must check the guest addresses of each
+ * block. The block of the current reference may be removed from the index while iterating, as long
+ * as the next reference is fetched first.
+ */
+u32int getFirstBlockInPageBucket(TranslationStore* ts, u32int page)
+{
+  return ts->pageIndex[getPageIndexBucket(page)];
+}
+
+
+u32int getNextBlockInPageBucket(TranslationStore* ts, u32int reference)
+{
+  return getPageLink(ts, reference)->next;
+}
+
+
+void setExecBitmap(GCONTXT* context, u32int start, u32int end)
+{
+  // mark every page the block overlaps
+  u32int page;
+  for (page = start >> 12; page <= (end >> 12); page++)
+  {
+    context->execBitmap[page >> 3] |= 1 << (page & 7);
   }
 }
 
@@ -175,15 +336,18 @@ void dumpBlock(BasicBlock* block)
   printf("dumpBlock: codeStoreSize %d\n", block->codeStoreSize);
   printf("dumpBlock: handler %p\n", block->handler);
   printf("dumpBlock: oneHypercall %x\n", block->oneHypercall);
+  printf("dumpBlock: lastUsed %x\n", block->lastUsed);
 }
 
 
 void dumpBlockStoreStats(GCONTXT* context)
 {
-  BasicBlock* index = context->translationStore->basicBlockStore;
-  u32int occupied = 0, free = 0;
+  TranslationStore* ts = context->translationStore;
+  BasicBlock* index = ts->basicBlockStore;
+  u32int occupied = 0, free = 0, grouped = 0;
   u32int i;
   u32int sizeOfBlocks = 0;
+  u32int totalDisplacement = 0, maxDisplacement = 0;
   for (i = 0; i < BASIC_BLOCK_STORE_SIZE; i++)
   {
     if (index[i].type == BB_TYPE_INVALID)
@@ -194,14 +358,50 @@ void dumpBlockStoreStats(GCONTXT* context)
     {
       occupied++;
       sizeOfBlocks += index[i].codeStoreSize;
+      if (index[i].type == GB_TYPE_ARM)
+      {
+        grouped++;
+      }
+      // distance from the home index; this is the probe length of the next lookup of the block
+      u32int displacement = (i - getBasicBlockStoreIndex((u32int)index[i].guestStart))
+                            & (BASIC_BLOCK_STORE_SIZE - 1);
+      totalDisplacement += displacement;
+      if (displacement > maxDisplacement)
+      {
+        maxDisplacement = displacement;
+      }
     }
   }
   printf("======================================================\n");
   printf("Basic Block Index Entries:    %08x\n", BASIC_BLOCK_STORE_SIZE);
   printf("Basic Block entries free:     %08x\n", free);
   printf("Basic Block entries occupied: %08x\n", occupied);
+  printf("Basic Block entries grouped:  %08x\n", grouped);
   printf("total used block store space %08x\n", sizeOfBlocks);
+  printf("code store segment:           %08x of %08x\n", ts->codeStoreSegment, CODE_STORE_SEGMENTS);
+  printf("total displacement:           %08x\n", totalDisplacement);
+  printf("maximum displacement:         %08x\n", maxDisplacement);
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+  printf("lookup hits:                  %08x\n", ts->lookupHits);
+  printf("lookup misses:                %08x\n", ts->lookupMisses);
+  printf("lookup probes:                %08x\n", ts->lookupProbes);
+  printf("lookup maximum probes:        %08x\n", ts->lookupMaxProbes);
+  printf("evictions:                    %08x\n", ts->evictions);
+  printf("group block evictions:        %08x\n", ts->groupEvictions);
+  printf("invalidations:                %08x\n", ts->invalidations);
+  printf("links created:                %08x\n", ts->linksCreated);
+  printf("links broken:                 %08x\n", ts->linksBroken);
+  printf("links live:                   %08x\n", ts->linksLive);
+  printf("links retained on removal:    %08x\n", ts->linksRetained);
+  printf("code store segments retired:  %08x\n", ts->segmentsRetired);
+  printf("blocks retired with segments: %08x\n", ts->blocksRetired);
+  printf("interrupt safepoints:         %08x\n", ts->safepoints);
+  printf("interrupts delivered:         %08x\n", ts->interruptsDelivered);
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  printf("indirect branch fills:        %08x\n", ts->indirectBranchFills);
+  printf("indirect branch conflicts:    %08x\n", ts->indirectBranchConflicts);
+  printf("indirect branch invalidated:  %08x\n", ts->indirectBranchInvalidations);
+#endif
+#endif
   printf("======================================================\n");
-
 }
-
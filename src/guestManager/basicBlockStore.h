@@ -9,7 +9,39 @@
 #include "guestManager/types.h"
 
 
-#define BASIC_BLOCK_STORE_SIZE      0x10000
+#define BASIC_BLOCK_STORE_BITS      16
+#define BASIC_BLOCK_STORE_SIZE      (1 << BASIC_BLOCK_STORE_BITS)
+
+/*
+ * Maximum number of consecutive block store entries examined for a single guest address. A block
+ * is always placed within this window of its home index; if the window is full the least recently
+ * used block in it is evicted.
+ */
+#define BASIC_BLOCK_STORE_PROBE_LIMIT  8
+
+/*
+ * The page index maps guest pages to the blocks in them. Pages are hashed into buckets by their
+ * low bits; each bucket holds a list of blocks that overlap any page of that bucket.
+ */
+#define BLOCK_PAGE_INDEX_BITS       12
+#define BLOCK_PAGE_INDEX_SIZE       (1 << BLOCK_PAGE_INDEX_BITS)
+
+/*
+ * The scanner ends a block before it enters a third page (see scanArmBlock()), so that a block is
+ * on at most two page index lists.
+ */
+#define BLOCK_MAX_PAGES             2
+
+#define BLOCK_INDEX_NONE            0xFFFFFFFFU
+
+#define PAGE_LINK_BLOCK_INDEX(reference)  ((reference) >> 1)
+#define PAGE_LINK_NUMBER(reference)       ((reference) & 1)
+#define PAGE_LINK_REFERENCE(index, link)  (((index) << 1) | (link))
+
+/*
+ * Blocks without a PC map (see scanner.c) must be rescanned to map host PCs to guest PCs.
+ */
+#define PC_MAP_NONE                 0xFFFFFFFFU
 
 
 struct TranslationStore;
@@ -24,6 +56,28 @@ enum basicBlockEntryType
 };
 typedef enum basicBlockEntryType basicBlockType;
 
+/*
+ * Outgoing link from an exit of a block, see blockLinker.c. next and prev are references to the
+ * other exits on the incoming link list of the target block.
+ */
+struct BlockLink
+{
+  u32int target;
+  u32int next;
+  u32int prev;
+};
+
+/*
+ * Link in a page index list. Each block is on the list of the page it starts in (link 0) and, if
+ * it ends in the next page, on the list of that page too (link 1). List references are encoded with
+ * PAGE_LINK_REFERENCE.
+ */
+struct BlockPageLink
+{
+  u32int next;
+  u32int prev;
+};
+
 struct BasicBlockEntry
 {
   basicBlockType type;
@@ -31,8 +85,16 @@ struct BasicBlockEntry
   u32int* guestEnd;
   u32int* codeStoreStart;
   u32int codeStoreSize;
+  /* number of PC map entries stored after the code of the block, or PC_MAP_NONE */
+  u32int pcMapSize;
   InstructionHandler handler;
   bool oneHypercall;
+  /* block store clock value at the last lookup of this block, used for eviction */
+  u32int lastUsed;
+  struct BlockPageLink pageLinks[BLOCK_MAX_PAGES];
+  struct BlockLink exitLinks[2];
+  /* head of the list of exits of other blocks that branch into this block */
+  u32int incomingLinks;
 };
 typedef struct BasicBlockEntry BasicBlock;
 
@@ -51,6 +113,13 @@ BasicBlock* getBasicBlockStoreEntry(struct TranslationStore* ts, u32int index);
 void addInstructionToBlock(struct TranslationStore* ts, BasicBlock* basicBlock, u32int instruction);
 
 void invalidateBlock(BasicBlock* block);
+void evictBlock(struct TranslationStore* ts, BasicBlock* block, u32int index);
+
+void addBlockToPageIndex(struct TranslationStore* ts, u32int index);
+void removeBlockFromPageIndex(struct TranslationStore* ts, u32int index);
+void clearPageIndex(struct TranslationStore* ts);
+u32int getFirstBlockInPageBucket(struct TranslationStore* ts, u32int page);
+u32int getNextBlockInPageBucket(struct TranslationStore* ts, u32int reference);
 
 void setExecBitmap(GCONTXT* context, u32int start, u32int end);
 bool isExecBitSet(GCONTXT* context, u32int addr);
@@ -7,4 +7,10 @@
 
 #define CODE_STORE_SIZE      __RAM_CODE_CACHE_POOL_END__ - __RAM_CODE_CACHE_POOL_BEGIN__
 
+/*
+ * The code store is filled one segment at a time. When the last segment is full, the code store
+ * wraps and the oldest segment is retired: only the blocks translated into it are invalidated.
+ */
+#define CODE_STORE_SEGMENTS  8
+
 #endif
\ No newline at end of file
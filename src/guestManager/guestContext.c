@@ -62,7 +62,12 @@ GCONTXT *createGuestContext(void)
   initialiseTranslationStore(context->translationStore);
 
   // virtual machine page table structs
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  context->pageTableCache = (pageTablesVM *)calloc(SHADOW_PAGE_TABLE_CACHE_SIZE, sizeof(pageTablesVM));
+  context->pageTables = context->pageTableCache;
+#else
   context->pageTables = (pageTablesVM *)calloc(1, sizeof(pageTablesVM));
+#endif
   if (context->pageTables == NULL)
   {
     DIE_NOW(context, "Failed to allocate page tables struct");
@@ -217,6 +222,12 @@ void dumpGuestContext(const GCONTXT *context)
   printf("Data abort pending: %x" EOL, context->guestDataAbtPending);
   printf("Prefetch abort pending: %x" EOL, context->guestPrefetchAbtPending);
   printf("Guest idle: %x" EOL, context->guestIdle);
+#ifdef CONFIG_IDLE_STATISTICS
+  printf("Idle periods: %#.8x, host wakeups: %#.8x, ticks: %#.8x" EOL, context->idlePeriods,
+      context->idleWakeups, context->idleTicks);
+  printf("Idle wakeup latency: total %#.8x, max %#.8x cycles" EOL,
+      context->idleWakeupLatencyCycles, context->idleMaxWakeupLatencyCycles);
+#endif
 
 #ifdef CONFIG_GUEST_CONTEXT_BLOCK_TRACE
   printf("Block trace:" EOL);
@@ -248,6 +259,9 @@ void dumpGuestContext(const GCONTXT *context)
 
   /* context switch counters */
   dumpCounters(&(context->counters));
+#ifdef CONFIG_REGISTER_MMIO_ACCESSES
+  dumpDeviceCounters(context->hardwareLibrary);
+#endif
 
 #ifdef CONFIG_STATS
   printf("timerTotalSvc:     %08x\n", timerTotalSvc);
@@ -36,6 +36,31 @@ enum guestOSType
   GUEST_OS_TEST
 };
 
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+/* number of guest address spaces whose shadow page tables are kept, see addressing.c */
+#define SHADOW_PAGE_TABLE_CACHE_SIZE  4
+/* trapped guest page table writes kept per switched out address space, see shadowMap.c */
+#define SHADOW_PAGE_TABLE_WRITE_LOG_SIZE  64
+
+struct PageTableWrite
+{
+  u32int physical;
+  u32int oldValue;
+};
+#endif
+
+#ifdef CONFIG_SOFTWARE_TLB
+/* number of entries in the software TLB, see getPhysicalAddress() */
+#define SOFTWARE_TLB_ENTRIES  64
+
+struct SoftwareTLBEntry
+{
+  simpleEntry* pageTable;
+  u32int virtualPage;
+  u32int physicalPage;
+};
+#endif
+
 struct VirtualMachinePageTables
 {
   simpleEntry* guestVirtual;
@@ -43,10 +68,25 @@ struct VirtualMachinePageTables
   simpleEntry* shadowPriv;
   simpleEntry* shadowUser;
   simpleEntry* shadowActive;
+  /* hardware ASIDs of the shadow page tables, with their generation (see addressing.c) */
+  u32int shadowPrivASID;
+  u32int shadowUserASID;
   u32int contextID;
   ptInfo* sptInfo;
   ptInfo* gptInfo;
   ptInfo* hptInfo;
+  /* sptInfo and gptInfo entries by 1st lvl page table index, see pageTableInfo.c */
+  ptInfo** ptInfoIndex;
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+  /* gptInfo entries whose guest page table writes are no longer trapped, see shadowMap.c */
+  ptInfo* unsyncedInfo;
+#endif
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  /* guest page table writes trapped while this address space was switched out, see shadowMap.c */
+  struct PageTableWrite writeLog[SHADOW_PAGE_TABLE_WRITE_LOG_SIZE];
+  u32int writeLogCount;
+  u32int lastActive;
+#endif
 };
 
 
@@ -101,6 +141,9 @@ struct guestContext
 #endif
   /* Virtual Addressing */
   pageTablesVM* pageTables;
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  pageTablesVM* pageTableCache;
+#endif
   simpleEntry* hypervisorPageTable;
   bool virtAddrEnabled;
   virtualMachine vm;
@@ -115,11 +158,23 @@ struct guestContext
   u32int guestIrqHandler;
   u32int guestFiqHandler;
   device * hardwareLibrary;
+  mmioDispatchTable *mmioDispatch;
   /* exception flags */
   bool guestIrqPending;
   bool guestDataAbtPending;
   bool guestPrefetchAbtPending;
   bool guestIdle;
+#ifdef CONFIG_IDLE_STATISTICS
+  /*
+   * idle periods, host wakeups while idle, 32 kHz ticks spent idle, and cycle counter ticks from
+   * the last wakeup to resuming the guest
+   */
+  u32int idlePeriods;
+  u32int idleWakeups;
+  u32int idleTicks;
+  u32int idleWakeupLatencyCycles;
+  u32int idleMaxWakeupLatencyCycles;
+#endif
   /* for OS-specific quirks */
   enum guestOSType os;
 
@@ -129,6 +184,9 @@ struct guestContext
   u8int *execBitmap;
 
   PerfCounters counters;
+#ifdef CONFIG_SOFTWARE_TLB
+  struct SoftwareTLBEntry softwareTLB[SOFTWARE_TLB_ENTRIES];
+#endif
 };
 
 
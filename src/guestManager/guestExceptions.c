@@ -47,185 +47,18 @@ void throwInterrupt(GCONTXT *context, u32int irqNumber)
   DEBUG(GUEST_EXCEPTIONS, "throwInterrupt: %x\n", irqNumber);
   DIE_NOW(context, "how was this called? shouldn't happen in hw passthrough\n");
 #else
-  switch (irqNumber)
+  setInterrupt(context, irqNumber);
+  // are we forwarding the interrupt event?
+  if (isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
   {
-    case GPT1_IRQ:
-    {
-      // gpt1 is dedicated to the guest.
-      setInterrupt(context, GPT1_IRQ);
-      // are we forwarding the interrupt event?
-      if (isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      else
-      {
-        DEBUG(GUEST_EXCEPTIONS, "throwInterrupt: guest is not ready to handle IRQ: %#.8x" EOL, irqNumber);
-      }
-      break;
-    }
-    case UART1_IRQ:
-    {
-      setInterrupt(context, UART1_IRQ);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case UART2_IRQ:
-    {
-      setInterrupt(context, UART2_IRQ);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case UART3_IRQ:
-    {
-      setInterrupt(context, UART3_IRQ);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case I2C1_IRQ:
-    {
-      setInterrupt(context, I2C1_IRQ);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case I2C2_IRQ:
-    {
-      setInterrupt(context, I2C2_IRQ);
-      // are we forwarding the interrupt event?
-      if (isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case I2C3_IRQ:
-    {
-      setInterrupt(context, I2C3_IRQ);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case MMC1_IRQ:
-    {
-      setInterrupt(context, MMC1_IRQ);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case MMC2_IRQ:
-    {
-      setInterrupt(context, MMC2_IRQ);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case MMC3_IRQ:
-    {
-      setInterrupt(context, MMC3_IRQ);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case SDMA_IRQ_0:
-    {
-      setInterrupt(context, SDMA_IRQ_0);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case SDMA_IRQ_1:
-    {
-      setInterrupt(context, SDMA_IRQ_1);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case SDMA_IRQ_2:
-    {
-      setInterrupt(context, SDMA_IRQ_2);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    case SDMA_IRQ_3:
-    {
-      setInterrupt(context, SDMA_IRQ_3);
-      // are we forwarding the interrupt event?
-      if ( isIrqPending(context->vm.irqController) && (context->CPSR.bits.I == 0))
-      {
-        // guest has enabled interrupts globally.
-        // set guest irq pending flag!
-        context->guestIrqPending = TRUE;
-      }
-      break;
-    }
-    default:
-    {
-      DIE_NOW(context, "throwInterrupt: from unknown source.");
-    }
+    // guest has enabled interrupts globally.
+    // set guest irq pending flag!
+    context->guestIrqPending = TRUE;
+  }
+  else
+  {
+    DEBUG(GUEST_EXCEPTIONS, "throwInterrupt: guest is not ready to handle IRQ: %#.8x" EOL,
+        irqNumber);
   }
 #endif
 }
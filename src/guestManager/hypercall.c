@@ -0,0 +1,171 @@
+#include "common/debug.h"
+#include "common/linker.h"
+
+#include "guestManager/hypercall.h"
+
+#include "memoryManager/addressing.h"
+#include "memoryManager/memoryConstants.h"
+#include "memoryManager/mmu.h"
+#include "memoryManager/pageTable.h"
+
+#ifdef CONFIG_UART_TX_BUFFER
+#include "drivers/beagle/beUart.h"
+#endif
+
+
+#define isGuestRamAddress(physAddr)                                                                \
+  ((physAddr) >= MEMORY_START_ADDR && (physAddr) < HYPERVISOR_BEGIN_ADDRESS)
+
+
+static u32int consoleWrite(GCONTXT *context, u32int buffer, u32int length);
+static u32int getGuestRamAddress(GCONTXT *context, u32int virtAddr);
+
+
+/*
+ * Performs the paravirtual call with the given code, if there is one. Returns FALSE when the code
+ * is not a hypercall, so that the caller can treat it as a normal SVC.
+ */
+bool hypercall(GCONTXT *context, u32int code)
+{
+  switch (code)
+  {
+    case HYPERCALL_CONSOLE_WRITE:
+    {
+      context->R0 = consoleWrite(context, context->R0, context->R1);
+      return TRUE;
+    }
+    default:
+    {
+      return FALSE;
+    }
+  }
+}
+
+/*
+ * Translates a guest virtual address through the guest's own page tables, or one to one while the
+ * guest MMU is off. Returns the physical address if it lies in guest RAM, or 0 for unmapped
+ * addresses, device memory and the hypervisor, so that the caller never touches them. Guest page tables are read at their physical addresses,
+ * so the hypervisor page table must be active.
+ */
+static u32int getGuestRamAddress(GCONTXT *context, u32int virtAddr)
+{
+  simpleEntry *gpt = context->pageTables->guestPhysical;
+  u32int physAddr;
+
+  if (!context->virtAddrEnabled)
+  {
+    // guest MMU is off; TTBR0 may still hold a stale page table
+    physAddr = virtAddr;
+  }
+  else if (gpt == NULL)
+  {
+    DEBUG(HYPERCALL, "getGuestRamAddress: guest MMU on without a page table" EOL);
+    return 0;
+  }
+  else
+  {
+    simpleEntry *guestFirst = getEntryFirst(gpt, virtAddr);
+    switch (guestFirst->type)
+    {
+      case SECTION:
+      {
+        sectionEntry *section = (sectionEntry *)guestFirst;
+        if (section->superSection)
+        {
+          return 0;
+        }
+        physAddr = (section->addr << 20) | (virtAddr & ~SECTION_MASK);
+        break;
+      }
+      case PAGE_TABLE:
+      {
+        u32int gptPhysAddr = ((pageTableEntry *)guestFirst)->addr << 10;
+        if (!isGuestRamAddress(gptPhysAddr))
+        {
+          return 0;
+        }
+        simpleEntry *guestSecond = (simpleEntry *)(gptPhysAddr | ((virtAddr & 0x000FF000) >> 10));
+        switch (guestSecond->type)
+        {
+          case LARGE_PAGE:
+          {
+            largePageEntry *largePage = (largePageEntry *)guestSecond;
+            physAddr = (largePage->addr << 16) | (virtAddr & ~LARGE_PAGE_MASK);
+            break;
+          }
+          case SMALL_PAGE:
+          case SMALL_PAGE_3:
+          {
+            smallPageEntry *smallPage = (smallPageEntry *)guestSecond;
+            physAddr = (smallPage->addr << 12) | (virtAddr & ~SMALL_PAGE_MASK);
+            break;
+          }
+          default:
+          {
+            return 0;
+          }
+        }
+        break;
+      }
+      default:
+      {
+        return 0;
+      }
+    }
+  }
+
+  return isGuestRamAddress(physAddr) ? physAddr : 0;
+}
+
+/*
+ * Copies a guest buffer to the serial output in one go, instead of one trapped THR store per
+ * character. At most HYPERCALL_CONSOLE_WRITE_MAX bytes are taken per call. Each page of the buffer
+ * is translated through the guest page tables and read at its physical address; the copy stops at
+ * the first page that is not guest RAM. Returns the number of bytes written, which the guest must
+ * check to write the rest of its buffer.
+ */
+static u32int consoleWrite(GCONTXT *context, u32int buffer, u32int length)
+{
+  DEBUG(HYPERCALL, "consoleWrite: %#.8x bytes @ %#.8x" EOL, length, buffer);
+
+  if (length > HYPERCALL_CONSOLE_WRITE_MAX)
+  {
+    length = HYPERCALL_CONSOLE_WRITE_MAX;
+  }
+
+  simpleEntry *ttbrBackup = mmuGetTTBR0();
+  mmuSetTTBR0(context->hypervisorPageTable, 0x1FF);
+
+  u32int written = 0;
+  while (written < length)
+  {
+    const u32int virtAddr = buffer + written;
+    const u32int physAddr = getGuestRamAddress(context, virtAddr);
+    if (physAddr == 0)
+    {
+      DEBUG(HYPERCALL, "consoleWrite: %#.8x is not guest RAM" EOL, virtAddr);
+      break;
+    }
+
+    u32int chunk = SMALL_PAGE_SIZE - (virtAddr & ~SMALL_PAGE_MASK);
+    if (chunk > length - written)
+    {
+      chunk = length - written;
+    }
+
+    const char *data = (const char *)physAddr;
+    u32int i;
+    for (i = 0; i < chunk; i++)
+    {
+#ifdef CONFIG_UART_TX_BUFFER
+      serialPutcAsync(data[i]);
+#else
+      printf("%c", (s32int)data[i]);
+#endif
+    }
+    written += chunk;
+  }
+
+  mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
+  return written;
+}
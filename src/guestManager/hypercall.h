@@ -0,0 +1,34 @@
+#ifndef __GUEST_MANAGER__HYPERCALL_H__
+#define __GUEST_MANAGER__HYPERCALL_H__
+
+#include "common/types.h"
+
+#include "guestManager/guestContext.h"
+
+
+/*
+ * Paravirtual calls are SVC instructions in privileged guest code. The scanner replaces those with
+ * a hypercall to svcInstruction(), so they never reach the guest's own SVC vector. SVCs executed
+ * in guest user mode are always delivered to the guest.
+ *
+ * Arguments and results are passed in R0-R3, like a function call.
+ */
+#define HYPERCALL_CONSOLE_WRITE  0xC0  // R0 = virtual address of buffer, R1 = length; R0 = bytes written
+
+/*
+ * Bytes taken by one HYPERCALL_CONSOLE_WRITE at most, to bound the time spent in the hypervisor.
+ * Fewer are written if part of the buffer is not mapped to guest RAM.
+ */
+#define HYPERCALL_CONSOLE_WRITE_MAX  0x1000
+
+#ifdef CONFIG_PARAVIRT_CONSOLE
+
+bool hypercall(GCONTXT *context, u32int code);
+
+#else
+
+#define hypercall(context, code)  FALSE
+
+#endif /* CONFIG_PARAVIRT_CONSOLE */
+
+#endif /* __GUEST_MANAGER__HYPERCALL_H__ */
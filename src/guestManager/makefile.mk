@@ -3,3 +3,4 @@ HYPARM_SRCS_C-y += guestManager/translationStore.c
 HYPARM_SRCS_C-y += guestManager/basicBlockStore.c
 HYPARM_SRCS_C-y += guestManager/guestExceptions.c
 HYPARM_SRCS_C-y += guestManager/scheduler.c
+HYPARM_SRCS_C-$(CONFIG_PARAVIRT_CONSOLE) += guestManager/hypercall.c
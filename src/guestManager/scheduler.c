@@ -1,5 +1,7 @@
 #include "common/debug.h"
 
+#include "drivers/beagle/be32kTimer.h"
+
 #include "guestManager/scheduler.h"
 
 #include "vm/omap35xx/intc.h"
@@ -7,6 +9,32 @@
 #include "cpuArch/armv7.h"
 
 
+#ifdef CONFIG_IDLE_STATISTICS
+static inline void countIdlePeriod(GCONTXT *context, u32int start, u32int end,
+                                   u32int wakeupCycle, u32int resumeCycle);
+
+/*
+ * Idle time is measured with the 32 kHz timer, which does not wrap around within an idle period.
+ * Wakeup latencies are a few microseconds, far below its resolution, so they are measured with the
+ * cycle counter.
+ */
+static inline void countIdlePeriod(GCONTXT *context, u32int start, u32int end,
+                                   u32int wakeupCycle, u32int resumeCycle)
+{
+  const u32int latency = resumeCycle - wakeupCycle;
+  context->idlePeriods++;
+  context->idleTicks += end - start;
+  context->idleWakeupLatencyCycles += latency;
+  if (latency > context->idleMaxWakeupLatencyCycles)
+  {
+    context->idleMaxWakeupLatencyCycles = latency;
+  }
+}
+#else
+#define countIdlePeriod(context, start, end, wakeupCycle, resumeCycle)
+#endif /* CONFIG_IDLE_STATISTICS */
+
+
 void scheduleGuest()
 {
   // TO IMPLEMENT:
@@ -37,22 +65,35 @@ void guestIdle(GCONTXT * context)
   // if guest had interrupts enabled, IRQ will fire as we return from hypercall
   // if guest had interrupts disabled, we will move it to the next instruction
   // which is the correct native behaviour
-  asm ("wfi\n\t");
+  waitForInterrupt();
 #else
   context->guestIdle = TRUE;
 
-  // enable interrupts if they were disabled...
-  enableInterrupts();
-
+  /*
+   * Sleep on the host until a physical interrupt raises a guest IRQ. The guest timer is the
+   * physical GPT1, so it wakes us up at the next guest timer deadline by itself.
+   *
+   * IRQs stay masked from the pending check until WFI, so that an IRQ that comes in between still
+   * ends WFI instead of leaving us asleep until the next one. Once awake, IRQs are unmasked just
+   * long enough to take the pending one.
+   */
+#ifdef CONFIG_IDLE_STATISTICS
+  enableCycleCounter();
+  const u32int start = getCounterVal();
+  u32int wakeupCycle = readCycleCounter();
+#endif
   while (!isIrqPending(context->vm.irqController))
   {
-    // delay
-    volatile u32int i = 0;
-    while (i < 1000000)
-    {
-      i++;
-    }
+    waitForInterrupt();
+#ifdef CONFIG_IDLE_STATISTICS
+    wakeupCycle = readCycleCounter();
+    context->idleWakeups++;
+#endif
+    enableInterrupts();
+    disableInterrupts();
   }
+  countIdlePeriod(context, start, getCounterVal(), wakeupCycle, readCycleCounter());
+
   context->guestIdle = FALSE;
 #endif
 }
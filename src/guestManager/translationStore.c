@@ -8,21 +8,75 @@
 #include "guestManager/codeStore.h"
 
 #include "instructionEmu/blockLinker.h"
+#include "instructionEmu/indirectBranchCache.h"
 #include "instructionEmu/scanner.h"
 
 #include "memoryManager/mmu.h"
 
 
-void initialiseTranslationStore(TranslationStore* ts)
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+static inline void countInvalidation(TranslationStore* ts);
+static inline void countSegmentRetired(TranslationStore* ts, u32int blocks);
+
+static inline void countInvalidation(TranslationStore* ts)
 {
-  DEBUG(TRANSLATION_STORE, "initialiseTranslationStore: translation store @ %p" EOL, ts);
+  ts->invalidations++;
+}
+
+static inline void countSegmentRetired(TranslationStore* ts, u32int blocks)
+{
+  ts->segmentsRetired++;
+  ts->blocksRetired += blocks;
+}
+#else
+#define countInvalidation(ts)
+#define countSegmentRetired(ts, blocks)
+#endif /* CONFIG_BLOCK_STORE_STATISTICS */
+
+
+static void initialiseCodeStore(TranslationStore* ts);
+static void removeBlock(GCONTXT* context, u32int index);
+static void retireCodeStoreSegment(TranslationStore* ts, u32int segment);
+static void setCodeStoreSegment(TranslationStore* ts, u32int segment);
+static inline u32int* getCodeStoreSegmentStart(TranslationStore* ts, u32int segment);
+
 
+static inline u32int* getCodeStoreSegmentStart(TranslationStore* ts, u32int segment)
+{
+  return ts->codeStore + segment * ((RAM_CODE_CACHE_POOL_END - (u32int)ts->codeStore)
+                                    / (CODE_STORE_SEGMENTS * sizeof(u32int)));
+}
+
+
+static void initialiseCodeStore(TranslationStore* ts)
+{
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  // translated code can only read from the code store; keep the indirect branch caches in there.
+  ts->indirectBranchCache = (struct IndirectBranchCacheEntry*)RAM_CODE_CACHE_POOL_BEGIN;
+  ts->returnAddressCache = ts->indirectBranchCache + INDIRECT_BRANCH_CACHE_SIZE;
+  ts->indirectBranchTrapCache = ts->returnAddressCache + INDIRECT_BRANCH_CACHE_SIZE;
+  ts->indirectBranchLookup = (struct IndirectBranchCacheEntry**)(ts->indirectBranchTrapCache
+                                                                 + INDIRECT_BRANCH_CACHE_SIZE);
+  ts->codeStore = (u32int*)(ts->indirectBranchLookup + 2);
+#else
   ts->codeStore = (u32int*)RAM_CODE_CACHE_POOL_BEGIN;
-  DEBUG(TRANSLATION_STORE, "initialiseTranslationStore: code store @ %p\n", ts->codeStore);
+#endif
   // STARFIX: remove all memset zero for naive memory allocator
-  memset(ts->codeStore, 0, RAM_CODE_CACHE_POOL_END-RAM_CODE_CACHE_POOL_BEGIN);
+  memset(ts->codeStore, 0, RAM_CODE_CACHE_POOL_END - (u32int)ts->codeStore);
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  clearIndirectBranchCache(ts);
+#endif
+
+  setCodeStoreSegment(ts, 0);
+}
 
-  ts->codeStoreFreePtr = ts->codeStore;
+
+void initialiseTranslationStore(TranslationStore* ts)
+{
+  DEBUG(TRANSLATION_STORE, "initialiseTranslationStore: translation store @ %p" EOL, ts);
+
+  initialiseCodeStore(ts);
+  DEBUG(TRANSLATION_STORE, "initialiseTranslationStore: code store @ %p\n", ts->codeStore);
   DEBUG(TRANSLATION_STORE, "initialiseTranslationStore: code store free ptr @ %p\n", ts->codeStoreFreePtr);
 
   DEBUG(TRANSLATION_STORE, "initialiseTranslationStore basic block entry size %x\n", sizeof(BasicBlock));
@@ -34,7 +88,40 @@ void initialiseTranslationStore(TranslationStore* ts)
   DEBUG(TRANSLATION_STORE, "initialiseTranslationStore: basic block store @ %p\n", ts->basicBlockStore);
   // STARFIX: remove all memset zero for naive memory allocator
   memset(ts->basicBlockStore, 0, BASIC_BLOCK_STORE_SIZE * sizeof(BasicBlock));
+  ts->blockStoreClock = 0;
+
+  ts->pageIndex = (u32int*)malloc(BLOCK_PAGE_INDEX_SIZE * sizeof(u32int));
+  if (ts->pageIndex == NULL)
+  {
+    DIE_NOW(context, "Failed to allocate block page index");
+  }
+  DEBUG(TRANSLATION_STORE, "initialiseTranslationStore: block page index @ %p\n", ts->pageIndex);
+  clearPageIndex(ts);
+
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+  ts->lookupHits = 0;
+  ts->lookupMisses = 0;
+  ts->lookupProbes = 0;
+  ts->lookupMaxProbes = 0;
+  ts->evictions = 0;
+  ts->groupEvictions = 0;
+  ts->invalidations = 0;
+  ts->linksCreated = 0;
+  ts->linksBroken = 0;
+  ts->linksLive = 0;
+  ts->linksRetained = 0;
+  ts->segmentsRetired = 0;
+  ts->blocksRetired = 0;
+  ts->safepoints = 0;
+  ts->interruptsDelivered = 0;
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  ts->indirectBranchFills = 0;
+  ts->indirectBranchConflicts = 0;
+  ts->indirectBranchInvalidations = 0;
+#endif
+#endif
 
+  ts->safepointBlock = BLOCK_INDEX_NONE;
   ts->write = TRUE;
 }
 
@@ -52,86 +139,164 @@ void instructionToCodeStore(TranslationStore* ts, u32int instruction)
 }
 
 
+static void setCodeStoreSegment(TranslationStore* ts, u32int segment)
+{
+  ts->codeStoreSegment = segment;
+  ts->codeStoreFreePtr = getCodeStoreSegmentStart(ts, segment);
+  ts->codeStoreSegmentEnd = getCodeStoreSegmentStart(ts, segment + 1);
+}
+
+
+/*
+ * Invalidates all blocks whose translated code lives in the given code store segment. Blocks in
+ * other segments that branch into them are unlinked; all other links stay.
+ */
+static void retireCodeStoreSegment(TranslationStore* ts, u32int segment)
+{
+  GCONTXT* context = getActiveGuestContext();
+  u32int* segmentStart = getCodeStoreSegmentStart(ts, segment);
+  u32int* segmentEnd = getCodeStoreSegmentStart(ts, segment + 1);
+  u32int blocks = 0;
+  u32int i;
+
+  DEBUG(TRANSLATION_STORE, "retireCodeStoreSegment: segment %x @ %p--%p" EOL, segment, segmentStart,
+        segmentEnd);
+
+  /*
+   * Segment membership follows from the location of the code of a block. Walking the block store
+   * once per retired segment is cheap compared to filling a segment, and saves keeping per-segment
+   * lists in every block store entry.
+   */
+  for (i = 0; i < BASIC_BLOCK_STORE_SIZE; i++)
+  {
+    BasicBlock* block = &ts->basicBlockStore[i];
+    if (block->type != BB_TYPE_INVALID && block->codeStoreStart >= segmentStart
+        && block->codeStoreStart < segmentEnd)
+    {
+      removeBlock(context, i);
+      blocks++;
+    }
+  }
+  countSegmentRetired(ts, blocks);
+}
+
+
+/*
+ * Called when the block being translated runs into the end of the current code store segment. The
+ * next segment (wrapping around at the end of the code store) is retired, and the part of the block
+ * that was already translated is moved to its start.
+ */
+void startNextCodeStoreSegment(TranslationStore* ts, BasicBlock* basicBlock)
+{
+  u32int segment = (ts->codeStoreSegment + 1) % CODE_STORE_SEGMENTS;
+  DEBUG(TRANSLATION_STORE, "startNextCodeStoreSegment: segment %x full, moving on to %x" EOL,
+        ts->codeStoreSegment, segment);
+
+  retireCodeStoreSegment(ts, segment);
+  setCodeStoreSegment(ts, segment);
+
+  // copy instructions that have already been copied for this block to the new segment
+  u32int i;
+  u32int* instrPtr = basicBlock->codeStoreStart;
+  basicBlock->codeStoreStart = ts->codeStoreFreePtr;
+  for (i = 0; i < basicBlock->codeStoreSize; i++)
+  {
+    *ts->codeStoreFreePtr = *instrPtr;
+    ts->codeStoreFreePtr++;
+    instrPtr++;
+  }
+
+  if (ts->codeStoreFreePtr >= ts->codeStoreSegmentEnd)
+  {
+    DIE_NOW(0, "startNextCodeStoreSegment: block does not fit in a code store segment");
+  }
+}
+
+
 void clearTranslationsAll(TranslationStore* ts)
 {
   DEBUG(TRANSLATION_STORE, "clearTranslationsAll: clear all translations\n");
 
-  ts->codeStore = (u32int*)RAM_CODE_CACHE_POOL_BEGIN;
-  memset(ts->codeStore, 0, RAM_CODE_CACHE_POOL_END-RAM_CODE_CACHE_POOL_BEGIN);
-
-  ts->codeStoreFreePtr = ts->codeStore;
+  initialiseCodeStore(ts);
   DEBUG(TRANSLATION_STORE, "clearTranslationsAll: code store free ptr @ %p\n", ts->codeStoreFreePtr);
 
   DEBUG(TRANSLATION_STORE, "clearTranslationsAll: basic block store @ %p\n", ts->basicBlockStore);
   memset(ts->basicBlockStore, 0, BASIC_BLOCK_STORE_SIZE * sizeof(BasicBlock));
+  clearPageIndex(ts);
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+  ts->linksLive = 0;
+#endif
 
+  ts->safepointBlock = BLOCK_INDEX_NONE;
   ts->write = TRUE;
 }
 
 
-void clearTranslationsByAddress(TranslationStore* ts, u32int address)
+/*
+ * Removes a block from the block store. Only the blocks branching into it need to be unlinked.
+ */
+static void removeBlock(GCONTXT* context, u32int index)
 {
-  bool executed = isExecBitSet(getActiveGuestContext(), address);
-  if (!executed)
-  {
-    return;
-  }
+  TranslationStore* ts = context->translationStore;
+  BasicBlock* block = &ts->basicBlockStore[index];
+  unlinkRemovedBlock(context, index);
+  removeBlockFromPageIndex(ts, index);
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  removeIndirectBranchTarget(ts, block);
+#endif
+  // STARFIX: remove all memset zero for naive memory allocator
+  memset((void*)block, 0, sizeof(BasicBlock));
+  block->type = BB_TYPE_INVALID;
+}
 
-  u32int i = 0;
-  /* we traverse the complete block translation store
-   * looking for blocks containing this address
-   * since there may be the case that part of a group block
-   * falls in this range, and we cant remove a single part of a group block
-   * inside the loop we unlink all current group-blocks. */
-  for (i = 0; i < BASIC_BLOCK_STORE_SIZE; i++)
+
+/*
+ * Invalidates all blocks in the given guest page that overlap [addressStart, addressEnd].
+ */
+static void clearTranslationsInPage(GCONTXT* context, u32int page, u32int addressStart,
+                                    u32int addressEnd)
+{
+  TranslationStore* ts = context->translationStore;
+  u32int reference = getFirstBlockInPageBucket(ts, page);
+  while (reference != BLOCK_INDEX_NONE)
   {
-    if (ts->basicBlockStore[i].type == GB_TYPE_ARM)
-    {
-      unlinkBlock(&ts->basicBlockStore[i], i);
-    }
-    u32int guestStart = (u32int)(ts->basicBlockStore[i].guestStart);
-    u32int guestEnd = (u32int)(ts->basicBlockStore[i].guestEnd);
-    if ((guestStart <= address) && (guestEnd >= address))
+    u32int next = getNextBlockInPageBucket(ts, reference);
+    u32int index = PAGE_LINK_BLOCK_INDEX(reference);
+    BasicBlock* block = &ts->basicBlockStore[index];
+    u32int guestStart = (u32int)block->guestStart;
+    u32int guestEnd = (u32int)block->guestEnd + ARM_INSTRUCTION_SIZE - 1;
+    if ((guestStart <= addressEnd) && (guestEnd >= addressStart))
     {
-      // STARFIX: remove all memset zero for naive memory allocator
-      memset((void*)&ts->basicBlockStore[i], 0, sizeof(BasicBlock));
-      ts->basicBlockStore[i].type = BB_TYPE_INVALID;
+      DEBUG(TRANSLATION_STORE, "clearTranslationsInPage: block %x @ %#.8x--%#.8x" EOL, index,
+            guestStart, guestEnd);
+      removeBlock(context, index);
+      countInvalidation(ts);
     }
+    reference = next;
   }
 }
 
 
+void clearTranslationsByAddress(TranslationStore* ts, u32int address)
+{
+  clearTranslationsByAddressRange(ts, address, address);
+}
+
+
 void clearTranslationsByAddressRange(TranslationStore* ts, u32int addressStart, u32int addressEnd)
 {
-  bool startSet = isExecBitSet(getActiveGuestContext(), addressStart);
-  bool endSet = isExecBitSet(getActiveGuestContext(), addressEnd);
-  bool set = startSet | endSet;
-  if (!set)
+  GCONTXT* context = getActiveGuestContext();
+  u32int page;
+  /*
+   * Only visit the pages in the range we have ever executed code from; the execution bitmap is a
+   * cheap filter for the common case of a write to a page without translations. Within each page,
+   * the page index gives us exactly the blocks that may need to go.
+   */
+  for (page = addressStart >> 12; page <= (addressEnd >> 12); page++)
   {
-    // we have never cached any translations in this address range. nothing to clear.
-    return;
-  }
-  u32int i = 0;
-  /* we traverse the complete block translation store
-   * looking for blocks matching this address range.
-   * since there may be the case that part of a group block
-   * falls in this range, and we cant remove a single part of a group block
-   * inside the loop we unlink all current group-blocks. */
-  for (i = 0; i < BASIC_BLOCK_STORE_SIZE; i++)
-  {
-    if (ts->basicBlockStore[i].type == GB_TYPE_ARM)
-    {
-      unlinkBlock(&ts->basicBlockStore[i], i);
-    }
-    u32int guestStart = (u32int)(ts->basicBlockStore[i].guestStart);
-    u32int guestEnd = (u32int)(ts->basicBlockStore[i].guestEnd);
-    if ( ((guestStart >= addressStart) && (guestStart <= addressEnd)) ||
-         ((guestEnd >= addressStart) && (guestEnd <= addressEnd)) )
+    if (isExecBitSet(context, page << 12))
     {
-      // STARFIX: remove all memset zero for naive memory allocator
-      memset((void*)&ts->basicBlockStore[i], 0, sizeof(BasicBlock));
-      ts->basicBlockStore[i].type = BB_TYPE_INVALID;
+      clearTranslationsInPage(context, page, addressStart, addressEnd);
     }
   }
 }
-
@@ -17,17 +17,58 @@
 
 typedef struct TranslationStore
 {
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  /* at the start of the code store, see instructionEmu/indirectBranchCache.h */
+  struct IndirectBranchCacheEntry* indirectBranchCache;
+  struct IndirectBranchCacheEntry* returnAddressCache;
+  struct IndirectBranchCacheEntry* indirectBranchTrapCache;
+  /* caches read by the emitted lookups, of other indirect branches and of returns */
+  struct IndirectBranchCacheEntry** indirectBranchLookup;
+#endif
   u32int* codeStore;
   u32int* codeStoreFreePtr;
+  /* segment that is currently being filled, and its end */
+  u32int codeStoreSegment;
+  u32int* codeStoreSegmentEnd;
   BasicBlock* basicBlockStore;
+  /* heads of the page index lists, see BLOCK_PAGE_INDEX_SIZE */
+  u32int* pageIndex;
+  /* incremented on every block store lookup; stamped into BasicBlock.lastUsed */
+  u32int blockStoreClock;
   u32int spillLocation;
   bool write;
+  /* block whose exits trap until the next hypercall, see setInterruptSafepoint() */
+  u32int safepointBlock;
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+  u32int lookupHits;
+  u32int lookupMisses;
+  u32int lookupProbes;
+  u32int lookupMaxProbes;
+  u32int evictions;
+  u32int groupEvictions;
+  u32int invalidations;
+  u32int linksCreated;
+  u32int linksBroken;
+  u32int linksLive;
+  u32int linksRetained;
+  u32int segmentsRetired;
+  u32int blocksRetired;
+  u32int safepoints;
+  /* guest IRQs delivered from the hypercall path, mostly after a safepoint */
+  u32int interruptsDelivered;
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  u32int indirectBranchFills;
+  u32int indirectBranchConflicts;
+  u32int indirectBranchInvalidations;
+#endif
+#endif
 } TranslationStore;
 
 
 void initialiseTranslationStore(TranslationStore* ts);
 
 void instructionToCodeStore(TranslationStore* ts, u32int instruction);
+void startNextCodeStoreSegment(TranslationStore* ts, BasicBlock* basicBlock);
 
 void clearTranslationsAll(TranslationStore* ts);
 void clearTranslationsByAddress(TranslationStore* ts, u32int address);
@@ -3,41 +3,205 @@
 
 #include "instructionEmu/blockLinker.h"
 #include "instructionEmu/decoder/arm/structs.h"
+#include "instructionEmu/indirectBranchCache.h"
 #include "instructionEmu/scanner.h"
 #include "instructionEmu/translator/translator.h"
 
 #include "memoryManager/mmu.h"
 
 
+/*
+ * Every translated block ends in one or two hypercalls, followed by the block index:
+ *
+ *   [exit 0: conditional hypercall, only if !oneHypercall]
+ *    exit 1: unconditional hypercall
+ *    block index
+ *
+ * When the block linker patches an exit into a direct branch to the next block, the link is
+ * recorded in the exit links of the source block, and the exit is put on the incoming link list of
+ * the target block. Link references are encoded as (block store index << 1) | exit number. This
+ * allows breaking exactly the links into a block when it is removed, instead of all links.
+ */
+#define LINK_REFERENCE(index, exit)     (((index) << 1) | (exit))
+#define LINK_REFERENCE_INDEX(reference) ((reference) >> 1)
+#define LINK_REFERENCE_EXIT(reference)  ((reference) & 1)
+
+
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+static inline void countLinkCreated(TranslationStore* ts);
+static inline void countLinkBroken(TranslationStore* ts);
+static inline void countLinksRetained(TranslationStore* ts);
+static inline void countSafepoint(TranslationStore* ts);
+
+static inline void countLinkCreated(TranslationStore* ts)
+{
+  ts->linksCreated++;
+  ts->linksLive++;
+}
+
+static inline void countLinkBroken(TranslationStore* ts)
+{
+  ts->linksBroken++;
+  ts->linksLive--;
+}
+
+static inline void countLinksRetained(TranslationStore* ts)
+{
+  ts->linksRetained += ts->linksLive;
+}
+
+static inline void countSafepoint(TranslationStore* ts)
+{
+  ts->safepoints++;
+}
+#else
+#define countLinkCreated(ts)
+#define countLinkBroken(ts)
+#define countLinksRetained(ts)
+#define countSafepoint(ts)
+#endif /* CONFIG_BLOCK_STORE_STATISTICS */
+
+
+static inline u32int getExitAddress(BasicBlock* block, u32int exit);
+static inline struct BlockLink* getLink(TranslationStore* ts, u32int reference);
+static void addIncomingLink(TranslationStore* ts, u32int target, u32int reference);
+static void removeIncomingLink(TranslationStore* ts, u32int reference);
+static void restoreHypercall(BasicBlock* block, u32int index, u32int exit);
+static void updateBlockType(BasicBlock* block);
+
+
+static inline u32int getExitAddress(BasicBlock* block, u32int exit)
+{
+  // the last word is DATA (block index). the word before is the last exit.
+  return (u32int)block->codeStoreStart + (block->codeStoreSize - 3 + exit) * ARM_INSTRUCTION_SIZE;
+}
+
+
+static inline struct BlockLink* getLink(TranslationStore* ts, u32int reference)
+{
+  return &ts->basicBlockStore[LINK_REFERENCE_INDEX(reference)]
+      .exitLinks[LINK_REFERENCE_EXIT(reference)];
+}
+
+
+static void addIncomingLink(TranslationStore* ts, u32int target, u32int reference)
+{
+  BasicBlock* targetBlock = &ts->basicBlockStore[target];
+  struct BlockLink* link = getLink(ts, reference);
+  link->target = target;
+  link->prev = BLOCK_INDEX_NONE;
+  link->next = targetBlock->incomingLinks;
+  if (link->next != BLOCK_INDEX_NONE)
+  {
+    getLink(ts, link->next)->prev = reference;
+  }
+  targetBlock->incomingLinks = reference;
+  countLinkCreated(ts);
+}
+
+
+static void removeIncomingLink(TranslationStore* ts, u32int reference)
+{
+  struct BlockLink* link = getLink(ts, reference);
+  if (link->prev == BLOCK_INDEX_NONE)
+  {
+    ts->basicBlockStore[link->target].incomingLinks = link->next;
+  }
+  else
+  {
+    getLink(ts, link->prev)->next = link->next;
+  }
+  if (link->next != BLOCK_INDEX_NONE)
+  {
+    getLink(ts, link->next)->prev = link->prev;
+  }
+  link->target = BLOCK_INDEX_NONE;
+  countLinkBroken(ts);
+}
+
+
+/*
+ * Turns a linked exit of a block back into a hypercall, keeping the condition of the branch.
+ */
+static void restoreHypercall(BasicBlock* block, u32int index, u32int exit)
+{
+  u32int exitAddress = getExitAddress(block, exit);
+  u32int condition = *(u32int*)exitAddress & 0xF0000000;
+  u32int hypercall = ((INSTR_SWI | (index + 0x100)) & 0x0FFFFFFF) | condition;
+
+  *(u32int*)exitAddress = hypercall;
+  mmuCleanDCacheByMVAtoPOU(exitAddress);
+  mmuInvIcacheByMVAtoPOU(exitAddress);
+}
+
+
+/*
+ * A block is part of a group block as long as it has any incoming or outgoing links.
+ */
+static void updateBlockType(BasicBlock* block)
+{
+  if (block->incomingLinks != BLOCK_INDEX_NONE || block->exitLinks[0].target != BLOCK_INDEX_NONE
+      || block->exitLinks[1].target != BLOCK_INDEX_NONE)
+  {
+    block->type = GB_TYPE_ARM;
+  }
+  else
+  {
+    block->type = BB_TYPE_ARM;
+  }
+}
+
+
+void initialiseBlockLinks(BasicBlock* block)
+{
+  block->exitLinks[0].target = BLOCK_INDEX_NONE;
+  block->exitLinks[1].target = BLOCK_INDEX_NONE;
+  block->incomingLinks = BLOCK_INDEX_NONE;
+}
+
+
 void linkBlock(GCONTXT *context, u32int nextPC, u32int lastPC, BasicBlock* lastBlock)
 {
   DEBUG(LINKER, "linkBlock: nextPC=%08x, lastPC %08x, lastBlock %p type %x"
         EOL, nextPC, lastPC, lastBlock, lastBlock->type);
 
+  TranslationStore* ts = context->translationStore;
+
   // get next block
-  BlockInfo blockinfo = getBlockInfo(context->translationStore, nextPC);
+  BlockInfo blockinfo = getBlockInfo(ts, nextPC);
   if (blockinfo.blockFound == FALSE)
   {
     // next block not scanned yet. nothing to link to.
     return;
   }
   BasicBlock* nextBlock = blockinfo.blockPtr;
+  if (lastBlock->type == BB_TYPE_INVALID)
+  {
+    // the block we came from was removed while interpreting its last instruction.
+    return;
+  }
+  u32int lastIndex = lastBlock - ts->basicBlockStore;
 
   // must check wether it was the first or second hypercall
-  // to do that we get the address of the last word of the block in host cache
   u32int eobInstruction = *(lastBlock->guestEnd);
-  u32int lastInstrOfHostBlock = (u32int)lastBlock->codeStoreStart +
-                                (lastBlock->codeStoreSize-1) * ARM_INSTRUCTION_SIZE;
-  // this last word is DATA (block index). the word before is control flow
-  lastInstrOfHostBlock -= ARM_INSTRUCTION_SIZE;
+  u32int exit = 1;
   u32int conditionCode = 0xE0000000;
-  if (lastPC != lastInstrOfHostBlock)
+  if (lastPC != getExitAddress(lastBlock, 1))
   {
+    exit = 0;
     conditionCode = eobInstruction & 0xF0000000;
   }
 
+  u32int reference = LINK_REFERENCE(lastIndex, exit);
+  if (lastBlock->exitLinks[exit].target != BLOCK_INDEX_NONE)
+  {
+    // a linked exit only traps at an interrupt safepoint; the link is made again below.
+    removeIncomingLink(ts, reference);
+  }
+
   // must try to put a branch at lastPC direct to nextPC
   putBranch(lastPC, (u32int)nextBlock->codeStoreStart, conditionCode);
+  addIncomingLink(ts, blockinfo.blockIndex, reference);
 
   // make sure both blocks are marked as a group-block.
   lastBlock->type = GB_TYPE_ARM;
@@ -45,32 +209,149 @@ void linkBlock(GCONTXT *context, u32int nextPC, u32int lastPC, BasicBlock* lastB
 }
 
 
-void unlinkBlock(BasicBlock* block, u32int index)
+/*
+ * Breaks the outgoing links of a block, so that it traps into the hypervisor at its end again.
+ */
+void unlinkBlock(GCONTXT *context, u32int index)
 {
+  TranslationStore* ts = context->translationStore;
+  BasicBlock* block = &ts->basicBlockStore[index];
   DEBUG(LINKER, "unlinkBlock: block %p, index %x" EOL, block, index);
 
-  u32int hypercall = INSTR_SWI | (index + 0x100);
-  u32int lastInstrOfHostBlock = (u32int)block->codeStoreStart +
-                                (block->codeStoreSize-1) * ARM_INSTRUCTION_SIZE;
-  lastInstrOfHostBlock -= ARM_INSTRUCTION_SIZE;
+  u32int exit;
+  for (exit = 0; exit < 2; exit++)
+  {
+    u32int target = block->exitLinks[exit].target;
+    if (target != BLOCK_INDEX_NONE)
+    {
+      restoreHypercall(block, index, exit);
+      removeIncomingLink(ts, LINK_REFERENCE(index, exit));
+      updateBlockType(&ts->basicBlockStore[target]);
+    }
+  }
+  updateBlockType(block);
+}
+
 
-  // remove 'last' hypercall (or the only one if there werent more)
-  *(u32int*)lastInstrOfHostBlock = hypercall;
-  mmuCleanDCacheByMVAtoPOU(lastInstrOfHostBlock);
-  mmuInvIcacheByMVAtoPOU(lastInstrOfHostBlock);
+/*
+ * Called before a block is removed from the block store. All blocks that branch into the block
+ * are patched to trap into the hypervisor again; links of other blocks are left intact. The exits
+ * of the block itself are not patched, because its code becomes unreachable.
+ */
+void unlinkRemovedBlock(GCONTXT *context, u32int index)
+{
+  TranslationStore* ts = context->translationStore;
+  BasicBlock* block = &ts->basicBlockStore[index];
+  DEBUG(LINKER, "unlinkRemovedBlock: block %p, index %x" EOL, block, index);
 
-  if (!block->oneHypercall)
+  if (ts->safepointBlock == index)
   {
-    // two hypercalls! fix up condition code.
-    u32int condition = *(u32int*)(lastInstrOfHostBlock-ARM_INSTRUCTION_SIZE);
-    condition &= 0xF0000000;
-    hypercall = (hypercall & 0x0FFFFFFF) | condition;
+    // its exits need not be restored, since its code becomes unreachable.
+    ts->safepointBlock = BLOCK_INDEX_NONE;
+  }
+
+  if (block->type != GB_TYPE_ARM)
+  {
+    return;
+  }
+
+  while (block->incomingLinks != BLOCK_INDEX_NONE)
+  {
+    u32int reference = block->incomingLinks;
+    u32int sourceIndex = LINK_REFERENCE_INDEX(reference);
+    BasicBlock* source = &ts->basicBlockStore[sourceIndex];
+    restoreHypercall(source, sourceIndex, LINK_REFERENCE_EXIT(reference));
+    removeIncomingLink(ts, reference);
+    if (sourceIndex != index)
+    {
+      updateBlockType(source);
+    }
+  }
 
-    *(u32int*)(lastInstrOfHostBlock-ARM_INSTRUCTION_SIZE) = hypercall;
-    mmuCleanDCacheByMVAtoPOU(lastInstrOfHostBlock-ARM_INSTRUCTION_SIZE);
-    mmuInvIcacheByMVAtoPOU(lastInstrOfHostBlock-ARM_INSTRUCTION_SIZE);
+  u32int exit;
+  for (exit = 0; exit < 2; exit++)
+  {
+    u32int target = block->exitLinks[exit].target;
+    if (target != BLOCK_INDEX_NONE)
+    {
+      removeIncomingLink(ts, LINK_REFERENCE(index, exit));
+      updateBlockType(&ts->basicBlockStore[target]);
+    }
+  }
+
+  countLinksRetained(ts);
+}
+
+
+/*
+ * Makes a block trap into the hypervisor at its end, so that a pending interrupt is delivered
+ * even if the block is linked to others. Its linked exits are turned back into hypercalls, but
+ * unlike unlinkBlock(), the link records are kept: clearInterruptSafepoint() puts the branches back
+ * on the next trap. Only one block can be at a safepoint; setting another one clears the first.
+ * Indirect branches do not go through the exits, so the indirect branch lookups are made to miss.
+ */
+void setInterruptSafepoint(GCONTXT *context, u32int index)
+{
+  TranslationStore* ts = context->translationStore;
+  BasicBlock* block = &ts->basicBlockStore[index];
+  DEBUG(LINKER, "setInterruptSafepoint: block %p, index %x" EOL, block, index);
+
+  if (ts->safepointBlock != index)
+  {
+    clearInterruptSafepoint(context);
+  }
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  setIndirectBranchSafepoint(ts);
+#endif
+  if (ts->safepointBlock == index || block->type != GB_TYPE_ARM)
+  {
+    return;
+  }
+
+  u32int exit;
+  for (exit = 0; exit < 2; exit++)
+  {
+    if (block->exitLinks[exit].target != BLOCK_INDEX_NONE)
+    {
+      restoreHypercall(block, index, exit);
+    }
+  }
+  ts->safepointBlock = index;
+  countSafepoint(ts);
+}
+
+
+/*
+ * Puts back the branches of the block at the interrupt safepoint, if any, and the indirect branch
+ * lookups. Links that were broken in the meantime stay broken.
+ */
+void clearInterruptSafepoint(GCONTXT *context)
+{
+  TranslationStore* ts = context->translationStore;
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  clearIndirectBranchSafepoint(ts);
+#endif
+  u32int index = ts->safepointBlock;
+  if (index == BLOCK_INDEX_NONE)
+  {
+    return;
+  }
+
+  BasicBlock* block = &ts->basicBlockStore[index];
+  DEBUG(LINKER, "clearInterruptSafepoint: block %p, index %x" EOL, block, index);
+
+  u32int exit;
+  for (exit = 0; exit < 2; exit++)
+  {
+    u32int target = block->exitLinks[exit].target;
+    if (target != BLOCK_INDEX_NONE)
+    {
+      u32int exitAddress = getExitAddress(block, exit);
+      putBranch(exitAddress, (u32int)ts->basicBlockStore[target].codeStoreStart,
+          *(u32int*)exitAddress & 0xF0000000);
+    }
   }
-  block->type = BB_TYPE_ARM;
+  ts->safepointBlock = BLOCK_INDEX_NONE;
 }
 
 
@@ -78,12 +359,12 @@ void unlinkAllBlocks(GCONTXT *context)
 {
   u32int i = 0;
   /* we traverse the complete block translation store
-   * inside the loop we unlink all current group-blocks. */ 
+   * inside the loop we unlink all current group-blocks. */
   for (i = 0; i < BASIC_BLOCK_STORE_SIZE; i++)
   {
     if (context->translationStore->basicBlockStore[i].type == GB_TYPE_ARM)
     {
-      unlinkBlock(&context->translationStore->basicBlockStore[i], i);
+      unlinkBlock(context, i);
     }
   }
 }
@@ -6,8 +6,12 @@
 #include "guestManager/basicBlockStore.h"
 #include "guestManager/guestContext.h"
 
+void clearInterruptSafepoint(GCONTXT *context);
+void initialiseBlockLinks(BasicBlock* block);
 void linkBlock(GCONTXT *context, u32int nextPC, u32int lastPC, BasicBlock* lastBlock);
-void unlinkBlock(BasicBlock* block, u32int index);
+void setInterruptSafepoint(GCONTXT *context, u32int index);
+void unlinkBlock(GCONTXT *context, u32int index);
+void unlinkRemovedBlock(GCONTXT *context, u32int index);
 void unlinkAllBlocks(GCONTXT *context);
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef __INSTRUCTION_EMU__DECODER_H__
 #define __INSTRUCTION_EMU__DECODER_H__
 
+#include "common/compiler.h"
 #include "common/types.h"
 
 #include "instructionEmu/decoder/arm/structs.h"
@@ -50,4 +51,10 @@ struct decodingTableEntry *decodeArmInstruction(u32int instruction);
 
 #endif
 
+#ifdef CONFIG_DECODER_TABLE_LOOKUP
+void initDecoder(void) __cold__;
+#else
+#define initDecoder()
+#endif
+
 #endif
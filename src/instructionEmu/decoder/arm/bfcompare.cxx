@@ -6,13 +6,17 @@
 
 // cat tables.inc.c  | grep 'ENTRY(' | cut -d',' -f2 | sed 's/^\s*//' | sed 's/\s*$//' | sort | uniq | sed 's/^\(.\+\)$/const char *const \1 = "\1";/' 
 //
+const char *const _handler = "_handler";
 const char *const armAdcInstruction = "armAdcInstruction";
 const char *const armAddInstruction = "armAddInstruction";
+const char *const armAluImmInstruction = "armAluImmInstruction";
+const char *const armAluRegInstruction = "armAluRegInstruction";
 const char *const armAndInstruction = "armAndInstruction";
 const char *const armAsrInstruction = "armAsrInstruction";
 const char *const armBicInstruction = "armBicInstruction";
 const char *const armBInstruction = "armBInstruction";
 const char *const armBkptInstruction = "armBkptInstruction";
+const char *const armBlInstruction = "armBlInstruction";
 const char *const armBlxImmediateInstruction = "armBlxImmediateInstruction";
 const char *const armBlxRegisterInstruction = "armBlxRegisterInstruction";
 const char *const armBxInstruction = "armBxInstruction";
@@ -27,18 +31,34 @@ const char *const armDmbInstruction = "armDmbInstruction";
 const char *const armDsbInstruction = "armDsbInstruction";
 const char *const armEorInstruction = "armEorInstruction";
 const char *const armIsbInstruction = "armIsbInstruction";
+const char *const armLdmExcRetInstruction = "armLdmExcRetInstruction";
 const char *const armLdmInstruction = "armLdmInstruction";
+const char *const armLdmUserInstruction = "armLdmUserInstruction";
+const char *const armLdrbImmInstruction = "armLdrbImmInstruction";
 const char *const armLdrbInstruction = "armLdrbInstruction";
+const char *const armLdrbRegInstruction = "armLdrbRegInstruction";
+const char *const armLdrbtImmInstruction = "armLdrbtImmInstruction";
 const char *const armLdrbtInstruction = "armLdrbtInstruction";
+const char *const armLdrbtRegInstruction = "armLdrbtRegInstruction";
+const char *const armLdrdImmInstruction = "armLdrdImmInstruction";
 const char *const armLdrdInstruction = "armLdrdInstruction";
+const char *const armLdrdRegInstruction = "armLdrdRegInstruction";
 const char *const armLdrexbInstruction = "armLdrexbInstruction";
 const char *const armLdrexdInstruction = "armLdrexdInstruction";
 const char *const armLdrexhInstruction = "armLdrexhInstruction";
 const char *const armLdrexInstruction = "armLdrexInstruction";
+const char *const armLdrhImmInstruction = "armLdrhImmInstruction";
 const char *const armLdrhInstruction = "armLdrhInstruction";
+const char *const armLdrhRegInstruction = "armLdrhRegInstruction";
+const char *const armLdrhtImmInstruction = "armLdrhtImmInstruction";
 const char *const armLdrhtInstruction = "armLdrhtInstruction";
+const char *const armLdrhtRegInstruction = "armLdrhtRegInstruction";
+const char *const armLdrImmInstruction = "armLdrImmInstruction";
 const char *const armLdrInstruction = "armLdrInstruction";
+const char *const armLdrRegInstruction = "armLdrRegInstruction";
+const char *const armLdrtImmInstruction = "armLdrtImmInstruction";
 const char *const armLdrtInstruction = "armLdrtInstruction";
+const char *const armLdrtRegInstruction = "armLdrtRegInstruction";
 const char *const armLslInstruction = "armLslInstruction";
 const char *const armLsrInstruction = "armLsrInstruction";
 const char *const armMcrInstruction = "armMcrInstruction";
@@ -47,7 +67,9 @@ const char *const armMovtInstruction = "armMovtInstruction";
 const char *const armMovwInstruction = "armMovwInstruction";
 const char *const armMrcInstruction = "armMrcInstruction";
 const char *const armMrsInstruction = "armMrsInstruction";
+const char *const armMsrImmInstruction = "armMsrImmInstruction";
 const char *const armMsrInstruction = "armMsrInstruction";
+const char *const armMsrRegInstruction = "armMsrRegInstruction";
 const char *const armMvnInstruction = "armMvnInstruction";
 const char *const armOrrInstruction = "armOrrInstruction";
 const char *const armPldInstruction = "armPldInstruction";
@@ -63,17 +85,32 @@ const char *const armSevInstruction = "armSevInstruction";
 const char *const armSmcInstruction = "armSmcInstruction";
 const char *const armSrsInstruction = "armSrsInstruction";
 const char *const armStmInstruction = "armStmInstruction";
+const char *const armStmUserInstruction = "armStmUserInstruction";
+const char *const armStrbImmInstruction = "armStrbImmInstruction";
 const char *const armStrbInstruction = "armStrbInstruction";
+const char *const armStrbRegInstruction = "armStrbRegInstruction";
+const char *const armStrbtImmInstruction = "armStrbtImmInstruction";
 const char *const armStrbtInstruction = "armStrbtInstruction";
+const char *const armStrbtRegInstruction = "armStrbtRegInstruction";
+const char *const armStrdImmInstruction = "armStrdImmInstruction";
 const char *const armStrdInstruction = "armStrdInstruction";
+const char *const armStrdRegInstruction = "armStrdRegInstruction";
 const char *const armStrexbInstruction = "armStrexbInstruction";
 const char *const armStrexdInstruction = "armStrexdInstruction";
 const char *const armStrexhInstruction = "armStrexhInstruction";
 const char *const armStrexInstruction = "armStrexInstruction";
+const char *const armStrhImmInstruction = "armStrhImmInstruction";
 const char *const armStrhInstruction = "armStrhInstruction";
+const char *const armStrhRegInstruction = "armStrhRegInstruction";
+const char *const armStrhtImmInstruction = "armStrhtImmInstruction";
 const char *const armStrhtInstruction = "armStrhtInstruction";
+const char *const armStrhtRegInstruction = "armStrhtRegInstruction";
+const char *const armStrImmInstruction = "armStrImmInstruction";
 const char *const armStrInstruction = "armStrInstruction";
+const char *const armStrRegInstruction = "armStrRegInstruction";
+const char *const armStrtImmInstruction = "armStrtImmInstruction";
 const char *const armStrtInstruction = "armStrtInstruction";
+const char *const armStrtRegInstruction = "armStrtRegInstruction";
 const char *const armSubInstruction = "armSubInstruction";
 const char *const armSwpInstruction = "armSwpInstruction";
 const char *const armTeqInstruction = "armTeqInstruction";
@@ -81,14 +118,16 @@ const char *const armTstInstruction = "armTstInstruction";
 const char *const armWfeInstruction = "armWfeInstruction";
 const char *const armWfiInstruction = "armWfiInstruction";
 const char *const armYieldInstruction = "armYieldInstruction";
-const char *const _handler = "_handler";
 const char *const nopInstruction = "nopInstruction";
 const char *const svcInstruction = "svcInstruction";
 const char *const undefinedInstruction = "undefinedInstruction";
 
 // With -f3, non-NULL
+const char *const armALUimm = "armALUimm";
+const char *const armALUimmNoDest = "armALUimmNoDest";
 const char *const armALUImmRegRSR = "armALUImmRegRSR";
 const char *const armALUImmRegRSRNoDest = "armALUImmRegRSRNoDest";
+const char *const armALUreg = "armALUreg";
 const char *const armLdrdhPCInstruction = "armLdrdhPCInstruction";
 const char *const armLdrPCInstruction = "armLdrPCInstruction";
 const char *const armMovPCInstruction = "armMovPCInstruction";
@@ -124,6 +163,20 @@ static struct decodingTableEntry *decodeTSD(uint32_t instruction)
 }
 
 
+// Table lookup decoder, must find exactly the same entry as the table search decoder
+typedef uint32_t u32int;
+#define TRUE true
+#define FALSE false
+#include "lookup.inc.c"
+static ArmLookupList armLookupLists;
+static struct decodingTableEntry *decodeTLD(uint32_t instruction)
+{
+  struct decodingTableEntry **entry = armLookupLists[ARM_LOOKUP_UNCONDITIONAL(instruction)][ARM_LOOKUP_KEY(instruction)];
+  while ((instruction & (*entry)->mask) != (*entry)->value) ++entry;
+  return (*entry)->mask == 0 ? nullptr : *entry;
+}
+
+
 // Autodecoder
 struct Handler { struct { void operator =(void *str) { str_= reinterpret_cast<const char *>(str); } std::string str_; } barePtr; };
 int decodeAD(uint32_t instruction, Handler *handler)
@@ -138,12 +191,23 @@ int decodeAD(uint32_t instruction, Handler *handler)
 int main()
 {
   std::cout << std::hex << std::showbase;
+  const u32int poolSize = buildArmLookupLists(armCategories, armLookupLists, nullptr);
+  struct decodingTableEntry **pool = new struct decodingTableEntry *[poolSize];
+  if (poolSize == 0 || buildArmLookupLists(armCategories, armLookupLists, pool) != poolSize)
+  {
+    std::cout << "Cannot build table lookup lists" << std::endl;
+    return 1;
+  }
   for (uint64_t instr = 0; instr <= 0xFFFFFFFFu; ++instr)
   {
     std::ostringstream os;
 
     // Run TSD
     auto tsd = decodeTSD(instr);
+    if (decodeTLD(instr) != tsd)
+    {
+      std::cout << "Table lookup mismatch at " << instr << std::endl;
+    }
     os << " " << (tsd == nullptr ? "UND" : tsd->instructionString)
        << " TSD=" << (tsd == nullptr ? "undefined" : (tsd->code == IRC_SAFE ? "safe" : (tsd->code == IRC_PATCH_PC ? "patch" : (tsd->code == IRC_REMOVE ? "remove" : (tsd->code == IRC_REPLACE ? "replace" : "?")))))
        << "[i=" << (tsd != nullptr && tsd->handler != nullptr ? tsd->handler : "") << ",p=" << (tsd != nullptr && tsd->pcHandler != nullptr ? tsd->pcHandler : "") << "]";
@@ -0,0 +1,129 @@
+/*
+ * Direct-indexed lookup lists for the ARM decoding tables in tables.inc.c
+ *
+ * Instructions are keyed on bits [27:20] and [7:4], and on whether they are unconditional. For
+ * every key, the list holds the entries of the decoding table that can match an instruction with
+ * that key, in table order, up to and including the first entry that matches all of them. The top
+ * level category of an instruction is fully determined by its key, so decoding an instruction
+ * takes a single table lookup followed by a short search of its list.
+ *
+ * This file is shared with the exhaustive decoder comparison in bfcompare.cxx.
+ */
+
+#define ARM_LOOKUP_KEYS                        4096
+#define ARM_LOOKUP_KEY(instruction)            ((((instruction) >> 16) & 0xFF0) | (((instruction) >> 4) & 0xF))
+#define ARM_LOOKUP_KEY_MASK                    0x0FF000F0
+#define ARM_LOOKUP_UNCONDITIONAL(instruction)  ((instruction) >= 0xF0000000)
+#define ARM_LOOKUP_CONDITION_MASK              0xF0000000
+
+/* no decoding table has more entries than this */
+#define ARM_LOOKUP_MAX_LIST_LENGTH             64
+
+
+typedef struct decodingTableEntry **ArmLookupList[2][ARM_LOOKUP_KEYS];
+
+
+/*
+ * Returns whether an entry (or category) with the given mask and value can match any instruction
+ * with the given key bits. Conditional instructions can have any condition except 0b1111.
+ */
+static bool armLookupCanMatch(u32int mask, u32int value, u32int knownMask, u32int knownBits)
+{
+  if ((knownBits ^ value) & mask & knownMask)
+  {
+    return FALSE;
+  }
+  return (knownMask & ARM_LOOKUP_CONDITION_MASK)
+         || (mask & ARM_LOOKUP_CONDITION_MASK) != ARM_LOOKUP_CONDITION_MASK
+         || (value & ARM_LOOKUP_CONDITION_MASK) != ARM_LOOKUP_CONDITION_MASK;
+}
+
+/*
+ * Collects the list for one key in the given array and returns its length, or 0 if the top level
+ * category is not determined by the key.
+ */
+static u32int buildArmLookupList(struct decodingTable *categories, bool unconditional, u32int key,
+                                 struct decodingTableEntry **list)
+{
+  const u32int knownMask = ARM_LOOKUP_KEY_MASK | (unconditional ? ARM_LOOKUP_CONDITION_MASK : 0);
+  const u32int knownBits = ((key & 0xFF0) << 16) | ((key & 0xF) << 4)
+                         | (unconditional ? ARM_LOOKUP_CONDITION_MASK : 0);
+
+  while (!armLookupCanMatch(categories->mask, categories->value, knownMask, knownBits))
+  {
+    categories++;
+  }
+  if ((categories->mask & ~knownMask) || categories->table == NULL)
+  {
+    return 0;
+  }
+
+  struct decodingTableEntry *entry = categories->table;
+  u32int length = 0;
+  while (length < ARM_LOOKUP_MAX_LIST_LENGTH)
+  {
+    if (armLookupCanMatch(entry->mask, entry->value, knownMask, knownBits))
+    {
+      list[length++] = entry;
+      if ((entry->mask & ~knownMask) == 0)
+      {
+        return length;
+      }
+    }
+    entry++;
+  }
+  return 0;
+}
+
+/*
+ * Builds the lookup lists for all keys. The lists are stored in pool, which must be large enough
+ * to hold all of them; lists that are equal to the one of the previous key are shared. Returns
+ * the number of pool entries used, or 0 on failure. If pool is NULL, the lists are not stored but
+ * the number of pool entries is still computed.
+ */
+static u32int buildArmLookupLists(struct decodingTable *categories, ArmLookupList lists,
+                                  struct decodingTableEntry **pool)
+{
+  struct decodingTableEntry *list[ARM_LOOKUP_MAX_LIST_LENGTH];
+  struct decodingTableEntry *previous[ARM_LOOKUP_MAX_LIST_LENGTH];
+  u32int poolSize = 0;
+  u32int unconditional;
+  for (unconditional = 0; unconditional < 2; unconditional++)
+  {
+    u32int previousLength = 0;
+    u32int key;
+    for (key = 0; key < ARM_LOOKUP_KEYS; key++)
+    {
+      const u32int length = buildArmLookupList(categories, unconditional, key, list);
+      if (length == 0)
+      {
+        return 0;
+      }
+
+      bool shared = length == previousLength;
+      u32int i;
+      for (i = 0; shared && i < length; i++)
+      {
+        shared = list[i] == previous[i];
+      }
+      if (!shared)
+      {
+        for (i = 0; i < length; i++)
+        {
+          previous[i] = list[i];
+          if (pool != NULL)
+          {
+            pool[poolSize + i] = list[i];
+          }
+        }
+        previousLength = length;
+        poolSize += length;
+      }
+      if (pool != NULL)
+      {
+        lists[unconditional][key] = &pool[poolSize - length];
+      }
+    }
+  }
+  return poolSize;
+}
@@ -1,3 +1,5 @@
 HYPARM_SRCS_C-$(CONFIG_DECODER_AUTO) += instructionEmu/decoder/auto.c
 
 HYPARM_SRCS_C-$(CONFIG_DECODER_TABLE_SEARCH) += instructionEmu/decoder/tableSearch.c
+
+HYPARM_SRCS_C-$(CONFIG_DECODER_TABLE_LOOKUP) += instructionEmu/decoder/tableLookup.c
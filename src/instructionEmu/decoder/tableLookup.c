@@ -0,0 +1,54 @@
+#include "common/debug.h"
+#include "common/stddef.h"
+#include "common/stdlib.h"
+
+#include "instructionEmu/decoder.h"
+#include "instructionEmu/interpreter.h"
+
+#include "instructionEmu/translator/arm/pcHandlers.h"
+
+
+struct decodingTable
+{
+  u32int mask;             /* Recognise if (instr & mask) == value.  */
+  u32int value;
+  struct decodingTableEntry *table;
+};
+
+
+#include "instructionEmu/decoder/arm/tables.inc.c"
+#include "instructionEmu/decoder/arm/lookup.inc.c"
+
+
+static ArmLookupList armLookupLists;
+
+
+void initDecoder(void)
+{
+  const u32int poolSize = buildArmLookupLists(armCategories, armLookupLists, NULL);
+  if (poolSize == 0)
+  {
+    DIE_NOW(NULL, "decoding tables cannot be keyed on bits [27:20] and [7:4]");
+  }
+
+  struct decodingTableEntry **pool = (struct decodingTableEntry **)malloc(poolSize * sizeof(struct decodingTableEntry *));
+  if (pool == NULL)
+  {
+    DIE_NOW(NULL, "Failed to allocate decoder lookup lists.");
+  }
+  buildArmLookupLists(armCategories, armLookupLists, pool);
+
+  DEBUG(DECODER, "initDecoder: %#x lookup list entries" EOL, poolSize);
+}
+
+struct decodingTableEntry *decodeArmInstruction(u32int instruction)
+{
+  struct decodingTableEntry **entry =
+    armLookupLists[ARM_LOOKUP_UNCONDITIONAL(instruction)][ARM_LOOKUP_KEY(instruction)];
+  while ((instruction & (*entry)->mask) != (*entry)->value)
+  {
+    entry++;
+  }
+  DEBUG(DECODER, "decode: instruction = %#.8x, code = %x, handler = %p" EOL, instruction, (*entry)->code, (*entry)->handler);
+  return *entry;
+}
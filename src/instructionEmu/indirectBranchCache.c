@@ -0,0 +1,343 @@
+#include "common/bit.h"
+#include "common/debug.h"
+
+#include "cpuArch/constants.h"
+
+#include "instructionEmu/indirectBranchCache.h"
+
+#include "instructionEmu/translator/blockCopy.h"
+#include "instructionEmu/translator/translator.h"
+
+#include "memoryManager/pageTable.h"
+
+#include "perf/contextSwitchCounters.h"
+
+
+/*
+ * Raw encodings of the instructions of the lookup sequence, see armIndirectBranchLookup().
+ */
+#define IBC_PUSH_REGISTER        0xE52D0004 // STR     Rm, [SP, #-4]!
+#define IBC_PUSH_SCRATCH         0xE92D000F // STMDB   SP!, {R0-R3}
+#define IBC_SAVE_FLAGS           0xE10F3000 // MRS     R3, APSR
+#define IBC_LOAD_TARGET          0xE59D1000 // LDR     R1, [SP, #offset]
+#define IBC_LOAD_CACHE           0xE5900000 // LDR     R0, [R0]
+#define IBC_HASH_TARGET          0xE2012F00 // AND     R2, R1, #(mask ROR 30)
+#define IBC_INDEX_CACHE          0xE0800082 // ADD     R0, R0, R2, LSL #1
+#define IBC_LOAD_GUEST_PC        0xE5902000 // LDR     R2, [R0]
+#define IBC_COMPARE_GUEST_PC     0xE1520001 // CMP     R2, R1
+#define IBC_SKIP_ON_MISS         0x128FF000 // ADDNE   PC, PC, #offset
+#define IBC_LOAD_HOST_PC         0xE5902004 // LDR     R2, [R0, #4]
+#define IBC_STORE_HOST_PC        0xE58D2000 // STR     R2, [SP, #offset]
+#define IBC_RESTORE_FLAGS        0xE128F003 // MSR     APSR_nzcvq, R3
+#define IBC_POP_SCRATCH_AND_PC   0xE8BD800F // LDMIA   SP!, {R0-R3, PC}
+#define IBC_POP_SCRATCH          0xE8BD000F // LDMIA   SP!, {R0-R3}
+#define IBC_DROP_REGISTER        0xE28DD004 // ADD     SP, SP, #4
+#define IBC_SET_HIT_COUNTER      0xE3A02000 // MOV     R2, #(1 << counter)
+#define IBC_COUNT_HIT            0xEE092F9C // MCR     p15, 0, R2, c9, c12, 4 (PMSWINC)
+
+#define IBC_SCRATCH_SIZE         16
+
+/*
+ * Guest PC of an empty entry, given any guest PC that maps to the entry. It is odd, so it is never
+ * the start of a block, and it maps to another entry, so that an indirect branch to it cannot hit.
+ */
+#define IBC_INVALID_GUEST_PC(pc)     (((((pc) >> 2) ^ 1) << 2) | 1)
+#define IBC_IS_VALID_GUEST_PC(pc)    (((pc) & 1) == 0)
+
+
+#ifdef CONFIG_BLOCK_STORE_STATISTICS
+static inline void countIndirectBranchFill(TranslationStore* ts, bool conflict);
+static inline void countIndirectBranchInvalidation(TranslationStore* ts);
+
+static inline void countIndirectBranchFill(TranslationStore* ts, bool conflict)
+{
+  ts->indirectBranchFills++;
+  if (conflict)
+  {
+    ts->indirectBranchConflicts++;
+  }
+}
+
+static inline void countIndirectBranchInvalidation(TranslationStore* ts)
+{
+  ts->indirectBranchInvalidations++;
+}
+#else
+#define countIndirectBranchFill(ts, conflict)
+#define countIndirectBranchInvalidation(ts)
+#endif /* CONFIG_BLOCK_STORE_STATISTICS */
+
+
+static inline struct IndirectBranchCacheEntry* getIndirectBranchCacheEntry(
+    struct IndirectBranchCacheEntry* cache, u32int guestPC);
+static void setIndirectBranchCacheEntry(TranslationStore* ts, struct IndirectBranchCacheEntry* cache,
+                                        BasicBlock* block);
+static void invalidateIndirectBranchCacheEntry(TranslationStore* ts,
+                                               struct IndirectBranchCacheEntry* cache,
+                                               BasicBlock* block);
+static bool isPopPC(Instruction instr);
+
+
+static inline struct IndirectBranchCacheEntry* getIndirectBranchCacheEntry(
+    struct IndirectBranchCacheEntry* cache, u32int guestPC)
+{
+  // must match the AND/ADD pair in the emitted lookup
+  return &cache[(guestPC >> 2) & (INDIRECT_BRANCH_CACHE_SIZE - 1)];
+}
+
+
+/*
+ * LDMIA SP!, {..., PC} without the user/exception return bit, and without SP in the register list.
+ */
+static bool isPopPC(Instruction instr)
+{
+  return (instr.raw & 0x0FFF8000) == 0x08BD8000 && !(instr.ldStMulti.regList & (1 << GPR_SP));
+}
+
+
+/*
+ * Only unconditional branches to a register are looked up: BX Rm, MOV PC, Rm and a pop of PC. Any
+ * of these may still interwork or go to code that was never translated; both are cache misses.
+ */
+bool isIndirectBranchCacheable(Instruction instr)
+{
+  if (instr.branch.cc != AL)
+  {
+    return FALSE;
+  }
+  if ((instr.raw & 0x0FFFFFF0) == 0x012FFF10 || (instr.raw & 0x0FFFFFF0) == 0x01A0F000)
+  {
+    // BX Rm, MOV PC, Rm
+    return instr.BxReg.Rm != GPR_SP && instr.BxReg.Rm != GPR_PC;
+  }
+  return isPopPC(instr);
+}
+
+
+/*
+ * BX LR, MOV PC, LR and pops of PC.
+ */
+bool isReturn(Instruction instr)
+{
+  if ((instr.raw & 0x0FFFFFF0) == 0x012FFF10 || (instr.raw & 0x0FFFFFF0) == 0x01A0F000)
+  {
+    return instr.BxReg.Rm == GPR_LR;
+  }
+  return isPopPC(instr);
+}
+
+
+/*
+ * Emits the lookup of the target of an indirect branch, right before the hypercall of the block.
+ * Four scratch registers are pushed on the guest stack, on top of the guest target:
+ *
+ *   BX Rm / MOV PC, Rm                         LDMIA SP!, {..., PC}
+ *
+ *   STR     Rm, [SP, #-4]!
+ *   STMDB   SP!, {R0-R3}                       STMDB   SP!, {R0-R3}
+ *   MRS     R3, APSR
+ *   LDR     R1, [SP, #target]
+ *   MOVW    R0, #:lower16:lookup
+ *   MOVT    R0, #:upper16:lookup
+ *   LDR     R0, [R0]
+ *   AND     R2, R1, #mask
+ *   ADD     R0, R0, R2, LSL #1
+ *   LDR     R2, [R0]
+ *   CMP     R2, R1
+ *   ADDNE   PC, PC, #miss
+ *   LDR     R2, [R0, #4]
+ *   STR     R2, [SP, #target]
+ *   MSR     APSR_nzcvq, R3
+ *   LDMIA   SP!, {R0-R3, PC}                   LDMIA   SP!, {R0-R3}
+ *                                              LDMIA   SP!, {..., PC}
+ * miss:
+ *   MSR     APSR_nzcvq, R3
+ *   LDMIA   SP!, {R0-R3}
+ *   ADD     SP, SP, #4
+ *   [hypercall]
+ *
+ * A pop is only executed once the target was found, so that the hypercall can still interpret it
+ * on a miss. On a hit, the popped guest PC is replaced by the host PC in the slot that is freed by
+ * the pop. No branch instructions are used: findBlockIndexNumber() takes the first branch after a
+ * host PC for a block exit. The lookup word holds the address of the cache, see
+ * setIndirectBranchSafepoint().
+ *
+ * With CONFIG_REGISTER_RETURN_ADDRESS_CACHE, a return that hits increments a performance monitor
+ * event counter after storing the host PC, with a MOV R2 and a write to PMSWINC.
+ */
+void armIndirectBranchLookup(TranslationStore* ts, BasicBlock* block, Instruction instr)
+{
+  DEBUG(TRANSLATION_STORE, "armIndirectBranchLookup: block %p instruction %08x" EOL, block, instr.raw);
+
+  bool pop = isPopPC(instr);
+  u32int hitLength = pop ? 5 : 4;
+#ifdef CONFIG_REGISTER_RETURN_ADDRESS_CACHE
+  bool countHit = isReturn(instr);
+  if (countHit)
+  {
+    hitLength += 2;
+  }
+#endif
+  u32int targetOffset = IBC_SCRATCH_SIZE;
+  if (pop)
+  {
+    targetOffset += countBitsSet(instr.ldStMulti.regList & ~(1 << GPR_PC)) * ARM_INSTRUCTION_SIZE;
+  }
+  else
+  {
+    addInstructionToBlock(ts, block, IBC_PUSH_REGISTER | (instr.BxReg.Rm << 12));
+  }
+
+  addInstructionToBlock(ts, block, IBC_PUSH_SCRATCH);
+  addInstructionToBlock(ts, block, IBC_SAVE_FLAGS);
+  addInstructionToBlock(ts, block, IBC_LOAD_TARGET | targetOffset);
+  armWriteValueToRegister(ts, block, AL, GPR_R0,
+                          (u32int)&ts->indirectBranchLookup[isReturn(instr) ? 1 : 0]);
+  addInstructionToBlock(ts, block, IBC_LOAD_CACHE);
+  addInstructionToBlock(ts, block, IBC_HASH_TARGET | (INDIRECT_BRANCH_CACHE_SIZE - 1));
+  addInstructionToBlock(ts, block, IBC_INDEX_CACHE);
+  addInstructionToBlock(ts, block, IBC_LOAD_GUEST_PC);
+  addInstructionToBlock(ts, block, IBC_COMPARE_GUEST_PC);
+  // PC reads two instructions ahead; skip the remaining instructions of the hit path
+  addInstructionToBlock(ts, block, IBC_SKIP_ON_MISS | ((hitLength - 1) * ARM_INSTRUCTION_SIZE));
+  addInstructionToBlock(ts, block, IBC_LOAD_HOST_PC);
+  addInstructionToBlock(ts, block, IBC_STORE_HOST_PC | targetOffset);
+#ifdef CONFIG_REGISTER_RETURN_ADDRESS_CACHE
+  if (countHit)
+  {
+    addInstructionToBlock(ts, block, IBC_SET_HIT_COUNTER | (1 << RETURN_CACHE_HIT_COUNTER));
+    addInstructionToBlock(ts, block, IBC_COUNT_HIT);
+  }
+#endif
+  addInstructionToBlock(ts, block, IBC_RESTORE_FLAGS);
+  if (pop)
+  {
+    addInstructionToBlock(ts, block, IBC_POP_SCRATCH);
+    addInstructionToBlock(ts, block, instr.raw);
+  }
+  else
+  {
+    addInstructionToBlock(ts, block, IBC_POP_SCRATCH_AND_PC);
+  }
+
+  // miss
+  addInstructionToBlock(ts, block, IBC_RESTORE_FLAGS);
+  addInstructionToBlock(ts, block, IBC_POP_SCRATCH);
+  if (!pop)
+  {
+    addInstructionToBlock(ts, block, IBC_DROP_REGISTER);
+  }
+}
+
+
+static void setIndirectBranchCacheEntry(TranslationStore* ts, struct IndirectBranchCacheEntry* cache,
+                                        BasicBlock* block)
+{
+  struct IndirectBranchCacheEntry* entry = getIndirectBranchCacheEntry(cache,
+                                                                      (u32int)block->guestStart);
+  countIndirectBranchFill(ts, IBC_IS_VALID_GUEST_PC(entry->guestPC));
+
+  // the entry is invalid while its host PC changes: translated code reads the guest PC first.
+  entry->guestPC = IBC_INVALID_GUEST_PC((u32int)block->guestStart);
+  entry->hostPC = (u32int)block->codeStoreStart;
+  entry->guestPC = (u32int)block->guestStart;
+}
+
+
+static void invalidateIndirectBranchCacheEntry(TranslationStore* ts,
+                                               struct IndirectBranchCacheEntry* cache,
+                                               BasicBlock* block)
+{
+  struct IndirectBranchCacheEntry* entry = getIndirectBranchCacheEntry(cache,
+                                                                      (u32int)block->guestStart);
+  if (entry->guestPC == (u32int)block->guestStart
+      && entry->hostPC == (u32int)block->codeStoreStart)
+  {
+    entry->guestPC = IBC_INVALID_GUEST_PC((u32int)block->guestStart);
+    countIndirectBranchInvalidation(ts);
+  }
+}
+
+
+/*
+ * Called after the hypercall of a block ending in the given indirect branch found the translation
+ * of its target.
+ */
+void addIndirectBranchTarget(TranslationStore* ts, BasicBlock* block, Instruction instr)
+{
+  if (isReturn(instr))
+  {
+    countReturnCacheMiss(&getActiveGuestContext()->counters);
+    setIndirectBranchCacheEntry(ts, ts->returnAddressCache, block);
+  }
+  else
+  {
+    setIndirectBranchCacheEntry(ts, ts->indirectBranchCache, block);
+  }
+}
+
+
+/*
+ * Called when a block has been translated. If it starts right after a BL, it is where the callee
+ * returns to, so predict it as a return target before any return to it traps.
+ */
+void addReturnSite(TranslationStore* ts, BasicBlock* block)
+{
+  // the BL would be in another page, which may not be mapped
+  if (((u32int)block->guestStart & ~SMALL_PAGE_MASK) == 0)
+  {
+    return;
+  }
+
+  Instruction call = {.raw = *(block->guestStart - 1)};
+  if (isBranch(call) && branchLinks(call))
+  {
+    countReturnCacheFill(&getActiveGuestContext()->counters);
+    setIndirectBranchCacheEntry(ts, ts->returnAddressCache, block);
+  }
+}
+
+
+/*
+ * Called before a block is removed from the block store. Only the guest PC of an entry is
+ * invalidated, because translated code may be interrupted between reading its guest and host PC.
+ */
+void removeIndirectBranchTarget(TranslationStore* ts, BasicBlock* block)
+{
+  invalidateIndirectBranchCacheEntry(ts, ts->indirectBranchCache, block);
+  invalidateIndirectBranchCacheEntry(ts, ts->returnAddressCache, block);
+}
+
+
+/*
+ * Empties both caches, and the cache used at interrupt safepoints, which stays empty.
+ */
+void clearIndirectBranchCache(TranslationStore* ts)
+{
+  u32int i;
+  for (i = 0; i < INDIRECT_BRANCH_CACHE_SIZE; i++)
+  {
+    ts->indirectBranchCache[i].guestPC = IBC_INVALID_GUEST_PC(i << 2);
+    ts->returnAddressCache[i].guestPC = IBC_INVALID_GUEST_PC(i << 2);
+    ts->indirectBranchTrapCache[i].guestPC = IBC_INVALID_GUEST_PC(i << 2);
+  }
+  clearIndirectBranchSafepoint(ts);
+}
+
+
+/*
+ * Makes translated code trap into the hypervisor at its next indirect branch, like the exits of a
+ * block at an interrupt safepoint, by pointing the lookups at the empty cache.
+ */
+void setIndirectBranchSafepoint(TranslationStore* ts)
+{
+  ts->indirectBranchLookup[0] = ts->indirectBranchTrapCache;
+  ts->indirectBranchLookup[1] = ts->indirectBranchTrapCache;
+}
+
+
+void clearIndirectBranchSafepoint(TranslationStore* ts)
+{
+  ts->indirectBranchLookup[0] = ts->indirectBranchCache;
+  ts->indirectBranchLookup[1] = ts->returnAddressCache;
+}
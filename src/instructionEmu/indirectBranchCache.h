@@ -0,0 +1,50 @@
+#ifndef __INSTRUCTION_EMU__INDIRECT_BRANCH_CACHE_H__
+#define __INSTRUCTION_EMU__INDIRECT_BRANCH_CACHE_H__
+
+#include "common/types.h"
+
+#include "guestManager/basicBlockStore.h"
+#include "guestManager/translationStore.h"
+
+#include "instructionEmu/decoder/arm/structs.h"
+
+
+/*
+ * The indirect branch cache maps guest PCs to the translated code of the blocks starting there. It
+ * is consulted by code emitted at the end of blocks that end in an indirect branch, so that these
+ * blocks only trap into the hypervisor when the target is not in the cache.
+ *
+ * Translated code runs unprivileged and can only read from the code store, so the cache is placed
+ * at the start of the code store. The emitted lookup masks the guest PC with an ARM immediate, which
+ * limits the cache to 256 entries.
+ *
+ * Returns (BX LR, MOV PC, LR and pops of PC) use a separate cache of return addresses that follows
+ * the indirect branch cache, so that they do not compete with other indirect branches for entries.
+ * A block that starts right after a BL is predicted as a return target as soon as it is translated.
+ *
+ * The emitted lookup reads the address of the cache to use from the code store as well. While a
+ * block is at an interrupt safepoint, both addresses point to an empty cache instead, so that every
+ * indirect branch traps like the exits of that block do, without losing the cached targets.
+ */
+#define INDIRECT_BRANCH_CACHE_BITS     8
+#define INDIRECT_BRANCH_CACHE_SIZE     (1 << INDIRECT_BRANCH_CACHE_BITS)
+
+struct IndirectBranchCacheEntry
+{
+  u32int guestPC;
+  u32int hostPC;
+};
+
+
+bool isIndirectBranchCacheable(Instruction instr);
+bool isReturn(Instruction instr);
+void armIndirectBranchLookup(TranslationStore* ts, BasicBlock* block, Instruction instr);
+
+void addIndirectBranchTarget(TranslationStore* ts, BasicBlock* block, Instruction instr);
+void addReturnSite(TranslationStore* ts, BasicBlock* block);
+void removeIndirectBranchTarget(TranslationStore* ts, BasicBlock* block);
+void clearIndirectBranchCache(TranslationStore* ts);
+void setIndirectBranchSafepoint(TranslationStore* ts);
+void clearIndirectBranchSafepoint(TranslationStore* ts);
+
+#endif
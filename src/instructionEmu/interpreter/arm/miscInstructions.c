@@ -1,3 +1,4 @@
+#include "guestManager/hypercall.h"
 #include "guestManager/scheduler.h"
 
 #include "instructionEmu/interpreter/common.h"
@@ -218,6 +219,19 @@ u32int armYieldInstruction(GCONTXT *context, Instruction instr)
 
 u32int svcInstruction(GCONTXT *context, Instruction instr)
 {
+#ifdef CONFIG_PARAVIRT_CONSOLE
+  if (!context->CPSR.bits.T)
+  {
+    if (!ConditionPassed(instr.svc.cc))
+    {
+      return context->R15 + ARM_INSTRUCTION_SIZE;
+    }
+    if (hypercall(context, instr.svc.imm24))
+    {
+      return context->R15 + ARM_INSTRUCTION_SIZE;
+    }
+  }
+#endif
   TRACE(context, instr.raw);
   DIE_NOW(context, "svcInstruction: should not invoke interpreter");
 }
@@ -1,4 +1,5 @@
 HYPARM_SRCS_C-y += instructionEmu/blockLinker.c
+HYPARM_SRCS_C-$(CONFIG_INDIRECT_BRANCH_CACHE) += instructionEmu/indirectBranchCache.c
 HYPARM_SRCS_C-y += instructionEmu/loadStoreDecode.c
 HYPARM_SRCS_C-y += instructionEmu/scanner.c
 
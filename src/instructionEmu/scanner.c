@@ -12,6 +12,7 @@
 
 #include "instructionEmu/blockLinker.h"
 #include "instructionEmu/decoder.h"
+#include "instructionEmu/indirectBranchCache.h"
 #include "instructionEmu/decoder/arm/structs.h"
 #include "instructionEmu/scanner.h"
 #include "instructionEmu/translator/translator.h"
@@ -32,6 +33,40 @@ static BasicBlock* scanArmBlock(GCONTXT *context, u32int *guestStart, u32int blo
 static BasicBlock* scanThumbBlock(GCONTXT *context, u16int *start, u32int metaIndex);
 #endif
 
+/*
+ * The PC map of a block maps host PCs in its translation back to the guest instructions they were
+ * translated from. Most guest instructions are copied as is, so only the places where the distance
+ * between host and guest offsets changes are recorded. An entry holds a host offset in words and
+ * the offset of a guest instruction. A flat entry maps all host words up to the next entry to that
+ * guest instruction; a linear entry maps them to consecutive guest instructions, like the host words
+ * before the first entry. The map is stored in the code store, right after the block index.
+ */
+#define PC_MAP_FLAT                 0x00010000
+#define PC_MAP_ENTRY(guestOffset, hostOffset, flat)  (((guestOffset) << 17) | ((flat) ? PC_MAP_FLAT : 0) | (hostOffset))
+#define PC_MAP_GUEST_OFFSET(entry)  ((entry) >> 17)
+#define PC_MAP_HOST_OFFSET(entry)   ((entry) & 0xFFFF)
+#define PC_MAP_MAX_GUEST_OFFSET     0x7FFF
+#define PC_MAP_MAX_HOST_OFFSET      0xFFFF
+#define PC_MAP_MAX_ENTRIES          64
+
+static u32int pcMap[PC_MAP_MAX_ENTRIES];
+static u32int pcMapSize;
+
+static void addPCMapEntry(u32int guestOffset, u32int hostOffset, bool flat);
+static void mapGuestInstruction(u32int guestOffset, u32int hostStart, u32int hostEnd);
+static void storePCMap(TranslationStore* ts, BasicBlock* basicBlock);
+
+/*
+ * A block that would enter more than BLOCK_MAX_PAGES pages is cut short before the last word of its
+ * last page. That word becomes the end of the block without being translated, and the hypercall of
+ * the block continues the guest at it, see continueCutBlock().
+ */
+#define BLOCK_LAST_INSTRUCTION(guestStart) \
+  ((u32int *)(((((u32int)(guestStart) >> 12) + BLOCK_MAX_PAGES) << 12) - ARM_INSTRUCTION_SIZE))
+
+static u32int continueCutBlock(GCONTXT *context, Instruction instr);
+
+
 #ifdef CONFIG_SCANNER_COUNT_BLOCKS
 u64int scanBlockCounter;
 static inline u64int getScanBlockCounter(void);
@@ -219,6 +254,12 @@ BasicBlock* scanBlock(GCONTXT *context, u32int startAddress)
     return basicBlock;
   }
 
+  if (basicBlock->type != BB_TYPE_INVALID)
+  {
+    // no free entry near the home index of this block; reuse the entry of a cold block.
+    evictBlock(context->translationStore, basicBlock, blockIndex);
+  }
+
 #ifdef CONFIG_THUMB2
   if (context->CPSR.bits.T)
   {
@@ -246,15 +287,23 @@ BasicBlock* scanArmBlock(GCONTXT* context, u32int* guestStart, u32int blockStore
   basicBlock->codeStoreSize = 0;
   basicBlock->handler = NULL;
   basicBlock->type = BB_TYPE_ARM;
+  initialiseBlockLinks(basicBlock);
 
   // Scan guest code and copy to code store
   // translating instructions on the fly
   u32int* instructionPtr = guestStart;
+  u32int* const lastInstructionPtr = BLOCK_LAST_INSTRUCTION(guestStart);
+  u32int hostOffset = 0;
+  pcMapSize = 0;
 #ifdef CONFIG_DECODER_AUTO
   TranslateCode code;
   AnyHandler handler;
   while ((code = decodeArmInstruction(*instructionPtr, &handler)) != IRC_REPLACE)
   {
+    if (instructionPtr == lastInstructionPtr)
+    {
+      break;
+    }
     if (code == IRC_SAFE)
     {
       addInstructionToBlock(context->translationStore, block, *instructionPtr);
@@ -267,6 +316,10 @@ BasicBlock* scanArmBlock(GCONTXT* context, u32int* guestStart, u32int blockStore
   DecodedInstruction *decodedInstr;
   while((decodedInstr = decodeArmInstruction(*instructionPtr))->code != IRC_REPLACE)
   {
+    if (instructionPtr == lastInstructionPtr)
+    {
+      break;
+    }
     if (decodedInstr->code == IRC_SAFE)
     {
       addInstructionToBlock(context->translationStore, basicBlock, *instructionPtr);
@@ -276,19 +329,33 @@ BasicBlock* scanArmBlock(GCONTXT* context, u32int* guestStart, u32int blockStore
       decodedInstr->pcHandler(context->translationStore, basicBlock, (u32int)instructionPtr, *instructionPtr);
     }
 #endif
+    mapGuestInstruction(instructionPtr - guestStart, hostOffset, basicBlock->codeStoreSize);
+    hostOffset = basicBlock->codeStoreSize;
     instructionPtr++;
   }
 
   // Next instruction must be translated into hypercall.
 #ifdef CONFIG_DECODER_AUTO
+  const bool cut = code != IRC_REPLACE;
   DEBUG(SCANNER, "scanArmBlock: instruction %#.8x must be translated; handler = %p" EOL, *instructionPtr, handler.barePtr);
 #else
+  const bool cut = decodedInstr->code != IRC_REPLACE;
   DEBUG(SCANNER, "scanArmBlock: instruction %s must be translated; handler = %p" EOL, decodedInstr->instructionString, decodedInstr->handler);
 #endif
   Instruction instruction = {.raw = *instructionPtr};
   u32int cc = instruction.raw & 0xF0000000;
 
-  if (isBranch(instruction))
+  // everything emitted from here on belongs to the last instruction
+  addPCMapEntry(instructionPtr - guestStart, hostOffset, TRUE);
+
+  if (cut)
+  {
+    // block too long; the last instruction is not translated, the next block starts with it.
+    DEBUG(SCANNER, "scanArmBlock: block cut short at %p" EOL, instructionPtr);
+    addInstructionToBlock(context->translationStore, basicBlock, INSTR_SWI | (blockStoreIndex+0x100));
+    basicBlock->oneHypercall = TRUE;
+  }
+  else if (isBranch(instruction))
   {
     if (branchLinks(instruction))
     {
@@ -314,6 +381,13 @@ BasicBlock* scanArmBlock(GCONTXT* context, u32int* guestStart, u32int blockStore
   }
   else
   {
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+    // the lookup spills to the guest stack, which is only safe with virtual memory turned on
+    if (context->virtAddrEnabled && isIndirectBranchCacheable(instruction))
+    {
+      armIndirectBranchLookup(context->translationStore, basicBlock, instruction);
+    }
+#endif
     // not a branch
     addInstructionToBlock(context->translationStore, basicBlock, INSTR_SWI | (blockStoreIndex+0x100));
     basicBlock->oneHypercall = TRUE;
@@ -321,13 +395,14 @@ BasicBlock* scanArmBlock(GCONTXT* context, u32int* guestStart, u32int blockStore
 
   // plant block index as well. dirty hack, but fixes interrupt handling.
   addInstructionToBlock(context->translationStore, basicBlock, blockStoreIndex);
+  storePCMap(context->translationStore, basicBlock);
 
   // set guest end of block address
   basicBlock->guestEnd = instructionPtr;
 #ifdef CONFIG_DECODER_AUTO
-  basicBlock->handler = handler.handler;
+  basicBlock->handler = cut ? continueCutBlock : handler.handler;
 #else
-  basicBlock->handler = decodedInstr->handler;
+  basicBlock->handler = cut ? continueCutBlock : decodedInstr->handler;
 #endif
 
   DEBUG(SCANNER, "scanArmBlock: instr %08x @ %p SWIcode %02x hdlrFuncPtr %p" EOL,
@@ -344,10 +419,120 @@ BasicBlock* scanArmBlock(GCONTXT* context, u32int* guestStart, u32int blockStore
   mmuUnifyCaches((u32int)basicBlock->codeStoreStart, basicBlock->codeStoreSize);
 
   setExecBitmap(context, (u32int)basicBlock->guestStart, (u32int)basicBlock->guestEnd);
+  addBlockToPageIndex(context->translationStore, blockStoreIndex);
+#ifdef CONFIG_INDIRECT_BRANCH_CACHE
+  addReturnSite(context->translationStore, basicBlock);
+#endif
   return basicBlock;
 }
 
 
+/*
+ * Handler of a block that was cut short: its last instruction was not translated, so the guest
+ * continues at it. softwareInterrupt() has already set the guest PC to the end of the block.
+ */
+static u32int continueCutBlock(GCONTXT *context, Instruction instr)
+{
+  UNUSED(instr);
+  return context->R15;
+}
+
+
+static void addPCMapEntry(u32int guestOffset, u32int hostOffset, bool flat)
+{
+  if (pcMapSize == PC_MAP_NONE)
+  {
+    return;
+  }
+  if (pcMapSize > 0 && PC_MAP_HOST_OFFSET(pcMap[pcMapSize - 1]) == hostOffset)
+  {
+    // the previous entry does not cover any host words
+    pcMapSize--;
+  }
+  if (pcMapSize == PC_MAP_MAX_ENTRIES || guestOffset > PC_MAP_MAX_GUEST_OFFSET
+      || hostOffset > PC_MAP_MAX_HOST_OFFSET)
+  {
+    // too irregular or too big; leave it to rescanBlock()
+    pcMapSize = PC_MAP_NONE;
+    return;
+  }
+  pcMap[pcMapSize++] = PC_MAP_ENTRY(guestOffset, hostOffset, flat);
+}
+
+
+/*
+ * Called for every guest instruction of a block with the host offsets its translation starts and
+ * ends at.
+ */
+static void mapGuestInstruction(u32int guestOffset, u32int hostStart, u32int hostEnd)
+{
+  if (hostEnd - hostStart != 1)
+  {
+    addPCMapEntry(guestOffset, hostStart, TRUE);
+    addPCMapEntry(guestOffset + 1, hostEnd, FALSE);
+  }
+}
+
+
+/*
+ * Appends the PC map to the code of the block. The map is written like code, so that it moves
+ * along if the block runs into the end of a code store segment, but is not counted as code.
+ */
+static void storePCMap(TranslationStore* ts, BasicBlock* basicBlock)
+{
+  basicBlock->pcMapSize = pcMapSize;
+  if (pcMapSize == PC_MAP_NONE)
+  {
+    return;
+  }
+
+  u32int i;
+  for (i = 0; i < pcMapSize; i++)
+  {
+    addInstructionToBlock(ts, basicBlock, pcMap[i]);
+  }
+  basicBlock->codeStoreSize -= pcMapSize;
+}
+
+
+/*
+ * Maps a host PC in a block to the guest instruction it was translated from, with a binary search
+ * for the last PC map entry at or before the host PC.
+ */
+u32int lookupPCMap(BasicBlock* block, u32int hostPC)
+{
+  const u32int* map = block->codeStoreStart + block->codeStoreSize;
+  u32int hostOffset = (hostPC - (u32int)block->codeStoreStart) / ARM_INSTRUCTION_SIZE;
+  u32int low = 0;
+  u32int high = block->pcMapSize;
+  while (low < high)
+  {
+    u32int middle = (low + high) / 2;
+    if (PC_MAP_HOST_OFFSET(map[middle]) <= hostOffset)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  u32int guestOffset = hostOffset;
+  if (low > 0)
+  {
+    u32int entry = map[low - 1];
+    guestOffset = PC_MAP_GUEST_OFFSET(entry);
+    if (!(entry & PC_MAP_FLAT))
+    {
+      guestOffset += hostOffset - PC_MAP_HOST_OFFSET(entry);
+    }
+  }
+  DEBUG(SCANNER, "lookupPCMap: hostPC %#.8x -> guestPC %p" EOL, hostPC, block->guestStart + guestOffset);
+  return (u32int)(block->guestStart + guestOffset);
+}
+
+
 /*
  * re-scan-and-translate a guest basic block
  * do NOT copy anything into code store
@@ -378,6 +563,11 @@ u32int rescanBlock(GCONTXT *context, u32int blockStoreIndex, BasicBlock* block,
   while ((code = decodeArmInstruction(*instructionPtr, &handler)) != IRC_REPLACE)
   {
     DEBUG(SCANNER, "rescanBlock: guest instr ptr %p host %p" EOL, instructionPtr, context->translationStore->codeStoreFreePtr);
+    if (instructionPtr == block->guestEnd)
+    {
+      // the block was cut short here
+      break;
+    }
     if (code == IRC_SAFE)
     {
       addInstructionToBlock(context->translationStore, block, *instructionPtr);
@@ -391,6 +581,11 @@ u32int rescanBlock(GCONTXT *context, u32int blockStoreIndex, BasicBlock* block,
   while((decodedInstr = decodeArmInstruction(*instructionPtr))->code != IRC_REPLACE)
   {
     DEBUG(SCANNER, "rescanBlock: guest instr ptr %p host %p" EOL, instructionPtr, context->translationStore->codeStoreFreePtr);
+    if (instructionPtr == block->guestEnd)
+    {
+      // the block was cut short here
+      break;
+    }
     if (decodedInstr->code == IRC_SAFE)
     {
       addInstructionToBlock(context->translationStore, block, *instructionPtr);
@@ -419,6 +614,15 @@ u32int rescanBlock(GCONTXT *context, u32int blockStoreIndex, BasicBlock* block,
     instructionPtr++;
   }
 
+  if (hostPC < (u32int)(block->codeStoreStart + block->codeStoreSize))
+  {
+    // host PC lies in the code emitted for the last instruction of the block, e.g. in the lookup
+    // of an indirect branch.
+    context->translationStore->codeStoreFreePtr = csFreeBackup;
+    context->translationStore->write = TRUE;
+    return (u32int)instructionPtr;
+  }
+
   DIE_NOW(context, "rescanBlock: not sure if we should ever get here.\n");
 
   // just compiler happy
@@ -23,6 +23,7 @@
 BasicBlock* scanBlock(GCONTXT *context, u32int startAddress);
 
 u32int rescanBlock(GCONTXT *context, u32int blockStoreIndex, BasicBlock* block, u32int hostPC);
+u32int lookupPCMap(BasicBlock* block, u32int hostPC);
 
 __macro__ u32int fetchThumbInstr(u16int *instructionPointer);
 __macro__ bool txxIsThumb32(u32int instruction);
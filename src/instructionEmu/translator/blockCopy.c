@@ -89,18 +89,23 @@ void armRestoreRegister(TranslationStore* ts, BasicBlock* block, u32int cond, u3
 void armWritePCToRegister(TranslationStore* ts, BasicBlock* block,
                           u32int conditionCode, u32int reg, u32int pc)
 {
-  pc += 8;
+  armWriteValueToRegister(ts, block, conditionCode, reg, pc + 8);
+}
+
 
+void armWriteValueToRegister(TranslationStore* ts, BasicBlock* block,
+                             u32int conditionCode, u32int reg, u32int value)
+{
   // assemble MOVW
   //MOVW -> ARM ARM A8.6.96 p506
   //|COND|0011|0000|imm4| Rd |    imm12   |
   addInstructionToBlock(ts, block, (conditionCode << 28) | (0b00110000 << 20) |
-                      ((pc & 0xF000) << 4) | (reg << 12) | (pc & 0x0FFF));
+                      ((value & 0xF000) << 4) | (reg << 12) | (value & 0x0FFF));
 
-  pc >>= 16;
+  value >>= 16;
   // assemble MOVT
   //MOVT -> ARM ARM A8.6.99 p512
   //|COND|0011|0100|imm4| Rd |    imm12   |
   addInstructionToBlock(ts, block, (conditionCode << 28) | (0b00110100 << 20) |
-                      ((pc & 0xF000) << 4) | (reg << 12) | (pc & 0x0FFF));
+                      ((value & 0xF000) << 4) | (reg << 12) | (value & 0x0FFF));
 }
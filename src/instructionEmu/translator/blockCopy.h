@@ -11,6 +11,7 @@ void armSpillRegister(TranslationStore* ts, BasicBlock* block, u32int conditionC
 void armRestoreRegister(TranslationStore* ts, BasicBlock* block, u32int conditionCode, u32int reg);
 
 void armWritePCToRegister(TranslationStore* ts, BasicBlock* block, u32int conditionCode, u32int reg, u32int pc);
+void armWriteValueToRegister(TranslationStore* ts, BasicBlock* block, u32int conditionCode, u32int reg, u32int value);
 
 /* function to find a register that is not one of the arguments */
 __macro__ u32int getOtherRegister(u32int usedRegister);
@@ -10,6 +10,8 @@
 
 #include "memoryManager/mmu.h"
 
+#include "perf/contextSwitchCounters.h"
+
 
 void putBranch(u32int branchLocation, u32int branchTarget, u32int condition)
 {
@@ -97,21 +99,37 @@ u32int findBlockIndexNumber(GCONTXT *context, u32int hostPC)
 }
 
 
-u32int hostpcToGuestpc(GCONTXT* context)
+/*
+ * Translated code can leave the block it was entered at through links to other blocks, and through
+ * the indirect branch cache. Returns the index of the block the host PC of the guest lies in.
+ */
+u32int findCurrentBlockIndex(GCONTXT *context)
 {
   u32int index = context->lastEntryBlockIndex;
-  BasicBlock* block = getBasicBlockStoreEntry(context->translationStore, context->lastEntryBlockIndex);
+  BasicBlock* block = getBasicBlockStoreEntry(context->translationStore, index);
+  u32int hostPC = context->R15;
+
+  if (block->type != GB_TYPE_ARM && hostPC >= (u32int)block->codeStoreStart
+      && hostPC < (u32int)(block->codeStoreStart + block->codeStoreSize))
+  {
+    return index;
+  }
+  return findBlockIndexNumber(context, hostPC);
+}
+
+
+u32int hostpcToGuestpc(GCONTXT* context)
+{
+  u32int index = findCurrentBlockIndex(context);
+  BasicBlock* block = getBasicBlockStoreEntry(context->translationStore, index);
 
   // this value we are trying to map
   u32int hostPC = context->R15;
 
   if (block->type == GB_TYPE_ARM)
   {
-    // we are in group block! get the REAL block index number.
-    // and unlink. will make life easier.
-    index = findBlockIndexNumber(context, context->R15);
-    block = getBasicBlockStoreEntry(context->translationStore, index);
-    unlinkBlock(block, index);
+    // we are in group block! unlink. will make life easier.
+    unlinkBlock(context, index);
   }
 
   // if we are at the first instruction of code store block, we really know the mapping
@@ -119,9 +137,15 @@ u32int hostpcToGuestpc(GCONTXT* context)
   {
     return (u32int)block->guestStart;
   }
+  else if (block->pcMapSize != PC_MAP_NONE)
+  {
+    countPCMapping(&context->counters);
+    return lookupPCMap(block, hostPC);
+  }
   else
   {
     // well, there's work to do. lets rescan the block to find PC mapping
+    countPCMapRescan(&context->counters);
     return rescanBlock(context, index, block, hostPC);
   }
 }
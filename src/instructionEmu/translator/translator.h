@@ -14,6 +14,7 @@ bool isServiceCall(Instruction instr);
 bool isConditional(Instruction instr);
 
 u32int findBlockIndexNumber(GCONTXT *context, u32int hostPC);
+u32int findCurrentBlockIndex(GCONTXT *context);
 
 u32int hostpcToGuestpc(GCONTXT* context);
 
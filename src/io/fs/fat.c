@@ -84,6 +84,12 @@ int fatMount(fatfs *fs, blockDevice *dev, int partNum)
     printf("FAT32 bytes per sector not 512: %#x" EOL, fs->bytesPerSector);
     return -1;
   }
+  fs->fatCache = (u32int *)calloc(fs->bytesPerSector, sizeof(u8int));
+  if (fs->fatCache == NULL)
+  {
+    DIE_NOW(NULL, "fatMount: failed to allocate FAT sector cache");
+  }
+  fs->fatCacheSector = FAT_CACHE_INVALID;
   if (fs->numFats != 2)
   {
     printf("FAT32 number of FATs must be 2: %#x" EOL, fs->numFats);
@@ -250,11 +256,32 @@ u32int fatLoadClusFatSector(fatfs *fs, u32int clus, char *buf)
   return (clus & 0x7f) * 4;
 }
 
+/* Load the given sector of the FAT into the FAT sector cache, unless it is already there.
+   Returns the cached entries of that sector. */
+static u32int *fatLoadCachedFatSector(fatfs *fs, u32int fatSect)
+{
+  if (fs->fatCacheSector != fatSect)
+  {
+    if (fatBlockRead(fs, fs->fatBegin + fatSect, 1, fs->fatCache) != 1)
+    {
+      fs->fatCacheSector = FAT_CACHE_INVALID;
+      DIE_NOW(NULL, "fatLoadCachedFatSector: failed to read FAT sector");
+    }
+    fs->fatCacheSector = fatSect;
+  }
+  return fs->fatCache;
+}
+
+/* Write the FAT sector cache back to the card */
+static void fatStoreCachedFatSector(fatfs *fs)
+{
+  fatBlockWrite(fs, fs->fatBegin + fs->fatCacheSector, 1, fs->fatCache);
+}
+
 /* Gets the cluster number which is pointed to by clus */
 u32int fatGetNextClus(fatfs *fs, u32int clus)
 {
-  u32int offset = fatLoadClusFatSector(fs, clus, buffer);
-  u32int next = *(u32int*)(buffer+offset);
+  u32int next = fatLoadCachedFatSector(fs, clus >> 7)[clus & 0x7f];
   DEBUG(FS_FAT, "fatGetNextClus: current cluster %#.8x, next cluster = %#.8x" EOL, clus, next);
   return next;
 }
@@ -262,13 +289,12 @@ u32int fatGetNextClus(fatfs *fs, u32int clus)
 /* Set the value of the FAT entry to val */
 void fatSetClusterValue(fatfs *fs, u32int clus, u32int val)
 {
-  u32int offset = (clus & 0x7f) * 4;
-  fatBlockRead(fs, fs->fatBegin + (clus >> 7), 1, buffer);
+  u32int *entries = fatLoadCachedFatSector(fs, clus >> 7);
   DEBUG(FS_FAT, "fatSetClusterValue: Writing %#x to cluster: %#.8x" EOL, val, clus);
-  *(u32int*)(buffer+offset) = val;
+  entries[clus & 0x7f] = val;
 
   //write back change
-  fatBlockWrite(fs, fs->fatBegin + (clus >> 7), 1, buffer);
+  fatStoreCachedFatSector(fs);
 }
 
 
@@ -374,11 +400,11 @@ u32int fatGetFreeClus(fatfs *fs)
   // suddenly became free! so start at FAT index that we finished last time
   for (; nextFreeIndex < fs->sectorsPerFat; nextFreeIndex++)
   {
-    fatBlockRead(fs, fs->fatBegin + nextFreeIndex, 1, buffer);
+    u32int *entries = fatLoadCachedFatSector(fs, nextFreeIndex);
     int i = 0;
     for (i = 0; i < 128; i++)
     {
-      val = *(u32int*)(buffer + i*4);
+      val = entries[i];
       if (val == 0x0)
       {
         //free cluster!
@@ -490,61 +516,74 @@ int fwrite(fatfs *fs, file *handle, void *src, u32int length)
 }
 
 
-/* Read the data in a file in the root directory. */
+/* Read the data in a file in the root directory.
+   Clusters that follow each other on the card are read with a single block read directly into
+   out; only a partial last cluster, or any cluster when out is not word aligned, goes through the
+   block buffer. */
 int fread(fatfs *fs, file *handle, void *out, u32int maxlen)
 {
   DEBUG(FS_FAT, "fread: file '%s' max data length %#x" EOL, handle->dirEntry->filename, maxlen);
 
-  u32int i;
-
+  const u32int clusterSize = fs->sectorsPerCluster * fs->bytesPerSector;
+  const u32int maxRunLength = FAT_MAX_BLOCKS_PER_READ / fs->sectorsPerCluster;
+  const u32int length = handle->dirEntry->fileSize < maxlen ? handle->dirEntry->fileSize : maxlen;
   u32int currentCluster = handle->dirEntry->firstCluster;
   u32int currentLength = 0;
+  char *dst = (char *)out;
 
-  do
+  while (currentLength < length && !FAT_EOC_MARKER(currentCluster))
   {
-    fatBlockRead(fs, CLUSTER_REL_LBA(fs, currentCluster),
-                 fs->sectorsPerCluster, buffer);
+    u32int runLength = (length - currentLength) / clusterSize;
+    u32int nextCluster;
 
-    // for now ignore maxlen
-    if ((handle->dirEntry->fileSize - currentLength) <
-        (fs->sectorsPerCluster * fs->bytesPerSector))
+    if (runLength > 0 && !((u32int)dst & 3))
     {
-      u32int left = handle->dirEntry->fileSize - currentLength;
-      // remaining data to read is found in this cluster
-      for (i = 0; i < left; i++)
+      // extend the run over all whole clusters that directly follow the current one
+      if (runLength > maxRunLength)
       {
-        if (currentLength < maxlen)
-        {
-          *((char*)out) = buffer[i];
-          out = ((char*)out)+1;
-          currentLength++;
-        }
-        else
-        {
-          return currentLength;
-        }
-      } // for
-    } // if
+        runLength = maxRunLength;
+      }
+      u32int clusters = 1;
+      nextCluster = fatGetNextClus(fs, currentCluster);
+      while (clusters < runLength && nextCluster == currentCluster + clusters)
+      {
+        clusters++;
+        nextCluster = fatGetNextClus(fs, nextCluster);
+      }
+
+      const u32int blocks = clusters * fs->sectorsPerCluster;
+      DEBUG(FS_FAT, "fread: cluster %#.8x, run of %#x clusters" EOL, currentCluster, clusters);
+      if (fatBlockRead(fs, CLUSTER_REL_LBA(fs, currentCluster), blocks, dst) != blocks)
+      {
+        printf("fread: failed to read clusters %#x-%#x" EOL, currentCluster,
+               currentCluster + clusters - 1);
+        return currentLength;
+      }
+      dst += clusters * clusterSize;
+      currentLength += clusters * clusterSize;
+    }
     else
     {
-      for (i = 0; i < (fs->sectorsPerCluster * fs->bytesPerSector); i++)
+      // partial last cluster, or a destination the block device cannot store words to
+      u32int left = length - currentLength;
+      if (left > clusterSize)
       {
-        if (currentLength < maxlen)
-        {
-          *((char*)out) = buffer[i];
-          out = ((char*)out)+1;
-          currentLength++;
-        }
-        else
-        {
-          return currentLength;
-        }
+        left = clusterSize;
+      }
+      if (fatBlockRead(fs, CLUSTER_REL_LBA(fs, currentCluster), fs->sectorsPerCluster, buffer)
+          != fs->sectorsPerCluster)
+      {
+        printf("fread: failed to read cluster %#x" EOL, currentCluster);
+        return currentLength;
       }
+      memcpy(dst, buffer, left);
+      dst += left;
+      currentLength += left;
+      nextCluster = fatGetNextClus(fs, currentCluster);
     }
 
-    currentCluster = fatGetNextClus(fs, currentCluster);
+    currentCluster = nextCluster;
   }
-  while (!FAT_EOC_MARKER(currentCluster));
 
   return currentLength;
 }
@@ -569,24 +608,14 @@ int fdelete(fatfs *fs, file *handle)
 
   // now free up the used cluster chain
   u32int workingCluster = handle->dirEntry->firstCluster;
-  u32int fatSect = fs->sectorsPerFat+1;
-  u32int offset = 0;
   do
   {
-    // get FAT
-    if (fatSect != (workingCluster >> 7))
-    {
-      fatSect = workingCluster >> 7;
-      fatBlockRead(fs, fs->fatBegin + fatSect, 1, buffer);
-    }
-    offset = workingCluster & 0x7F;
-
-    u32int* entry = (u32int*)(&buffer[offset*4]);
+    u32int *entry = &fatLoadCachedFatSector(fs, workingCluster >> 7)[workingCluster & 0x7F];
     workingCluster = *entry;
     *entry = 0x0;
 
     // update FAT table block
-    fatBlockWrite(fs, fs->fatBegin + fatSect, 1, buffer);
+    fatStoreCachedFatSector(fs);
   }
   while (!FAT_EOC_MARKER(workingCluster));
 
@@ -666,21 +695,11 @@ file* fopen(fatfs *fs, const char *fname)
   // follow FAT chain to last cluster
   u32int currentCluster = f->dirEntry->firstCluster;
   u32int tempCluster = 0;
-  u32int fatSect = fs->sectorsPerFat+1;
-  u32int offset = 0;
   u32int fileSizeLeft = f->dirEntry->fileSize;
   do
   {
-    // get FAT
-    if (fatSect != (currentCluster >> 7))
-    {
-      fatSect = currentCluster >> 7;
-      fatBlockRead(fs, fs->fatBegin + fatSect, 1, buffer);
-    }
-
-    offset = currentCluster & 0x7F;
     tempCluster = currentCluster;
-    currentCluster = *(u32int*)(&buffer[offset*4]);
+    currentCluster = fatGetNextClus(fs, currentCluster);
     if (!FAT_EOC_MARKER(currentCluster))
     {
       fileSizeLeft = fileSizeLeft - fs->sectorsPerCluster * fs->bytesPerSector;
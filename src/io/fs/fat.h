@@ -20,6 +20,10 @@
 #define FAT_LF_MASK     0xF
 #define FAT_EOC_VAL     0xFFFFFFFF
 
+#define FAT_CACHE_INVALID        0xFFFFFFFF
+// the MMC host counts the blocks of a transfer in a 16-bit field
+#define FAT_MAX_BLOCKS_PER_READ  0xFFFF
+
 /* Representation of a "mounted" fat filesystem. */
 typedef struct FAT
 {
@@ -35,6 +39,8 @@ typedef struct FAT
   struct Partition *part;     // partition in primary table where this fs is located
   u32int fatBegin;            // partition relative fat location
   u32int clusterBegin;        // partition relative cluster begin location
+  u32int fatCacheSector;      // partition relative location of the cached FAT sector
+  u32int *fatCache;           // write-through copy of one FAT sector
 } fatfs;
 
 
@@ -26,6 +26,7 @@
 
 #include "guestManager/guestContext.h"
 
+#include "instructionEmu/decoder.h"
 #include "instructionEmu/scanner.h"
 
 #if !defined(CONFIG_NO_MMC) && !defined(CONFIG_HW_PASSTHROUGH)
@@ -139,6 +140,8 @@ void main(s32int argc, char *argv[])
   processCommandLine(&config, argc - 1, argv + 1);
   dumpRuntimeConfiguration(&config);
 
+  initDecoder();
+
   /* initialize guest context */
   GCONTXT *context = createGuestContext();
   activeGuestContext = context;
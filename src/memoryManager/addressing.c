@@ -15,6 +15,8 @@
 #include "memoryManager/pageTable.h"
 #include "memoryManager/shadowMap.h"
 
+#include "perf/contextSwitchCounters.h"
+
 
 typedef enum pageTableTarget
 {
@@ -32,7 +34,34 @@ extern const u32int usrVector;
 extern const u32int undVector;
 
 
+/*
+ * Each shadow page table gets its own hardware ASID, so that switching between the privileged and
+ * the unprivileged shadow page table does not require a TLB flush. All entries of the shadow page
+ * tables that differ between them are non-global. ASIDs are allocated from a generation: the ASID
+ * of a page table is only valid if its generation (kept in the upper bits) is the current one.
+ * When the ASIDs run out, a new generation is started and the whole TLB is flushed.
+ */
+#define ASID_BITS        8
+#define ASID_MASK        ((1 << ASID_BITS) - 1)
+#define ASID_FIRST       0x01
+#define ASID_LAST        0xFE
+#define ASID_NONE        0xFFFFFFFF
+
+
+static u32int asidGeneration = 1 << ASID_BITS;
+static u32int nextASID = ASID_FIRST;
+
+
 static void setupPageTable(GCONTXT *context, PageTableTarget target);
+static u32int allocateASID(GCONTXT *context);
+static u32int getASID(GCONTXT *context, u32int *asid);
+static u32int lookupASID(GCONTXT *context, simpleEntry *pageTable);
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+static void switchShadowPageTables(GCONTXT *context, u32int ttbr);
+
+// incremented on every address space switch; slots record it to find the least recently used
+static u32int pageTableCacheClock = 0;
+#endif
 
 
 void initVirtualAddressing(GCONTXT *context)
@@ -46,7 +75,7 @@ void initVirtualAddressing(GCONTXT *context)
 
   mmuInit();
   mmuSetDomain(HYPERVISOR_ACCESS_DOMAIN, client);
-  mmuSetTTBR0(context->hypervisorPageTable, 0);
+  mmuSetTTBR0(context->hypervisorPageTable, HYPERVISOR_CONTEXT_ID);
   mmuEnableVirtAddr();
 
   DEBUG(MM_ADDRESSING, "initVirtualAddressing: done" EOL);
@@ -97,6 +126,10 @@ static void setupPageTable(GCONTXT *context, PageTableTarget target)
     mapSection(pageTablePtr, staticRamStart, staticRamStart, HYPERVISOR_ACCESS_DOMAIN,
                HYPERVISOR_ACCESS_BITS, 0, 0, 0, 1);
 
+    // none of the above is mapped in the shadow page tables
+    setNonGlobal(context, pageTablePtr, MEMORY_START_ADDR, HYPERVISOR_BEGIN_ADDRESS);
+    setNonGlobal(context, pageTablePtr, BE_TIMER32K, BE_TIMER32K + SMALL_PAGE_SIZE);
+    setNonGlobal(context, pageTablePtr, staticRamStart, staticRamStart + SECTION_SIZE);
   }
 #ifndef CONFIG_HW_PASSTHROUGH
   else
@@ -142,6 +175,11 @@ static void setupPageTable(GCONTXT *context, PageTableTarget target)
   {
     mapRegion(pageTablePtr, RAM_CODE_CACHE_POOL_BEGIN, RAM_CODE_CACHE_POOL_BEGIN, RAM_CODE_CACHE_POOL_END,
               HYPERVISOR_ACCESS_DOMAIN, PRIV_RW_USR_RO, TRUE, FALSE, 0, FALSE);
+    if (target == PT_TARGET_GUEST_SHADOW_PRIVILEGED)
+    {
+      // not mapped in the unprivileged shadow page table
+      setNonGlobal(context, pageTablePtr, RAM_CODE_CACHE_POOL_BEGIN, RAM_CODE_CACHE_POOL_END);
+    }
   }
 }
 
@@ -152,6 +190,13 @@ static void setupPageTable(GCONTXT *context, PageTableTarget target)
 void guestSetPageTableBase(GCONTXT *gc, u32int ttbr)
 {
   DEBUG(MM_ADDRESSING, "guestSetPageTableBase: ttbr %#.8x @ pc %#.8x" EOL, ttbr, gc->R15);
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  if (gc->virtAddrEnabled)
+  {
+    switchShadowPageTables(gc, ttbr);
+    return;
+  }
+#endif
   gc->pageTables->guestPhysical = (simpleEntry *)ttbr;
   gc->pageTables->guestVirtual = NULL;
 
@@ -161,6 +206,104 @@ void guestSetPageTableBase(GCONTXT *gc, u32int ttbr)
   }
 }
 
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+/**
+ * guest is switching to another address space.
+ * shadow page tables of the last SHADOW_PAGE_TABLE_CACHE_SIZE address spaces are kept, keyed by
+ * the guest TTBR0. if the new one is cached, its shadow page tables are brought up to date and
+ * reused; otherwise the least recently used set is rebuilt for it.
+ **/
+static void switchShadowPageTables(GCONTXT *context, u32int ttbr)
+{
+  pageTablesVM* current = context->pageTables;
+  pageTablesVM* slot = NULL;
+  u32int i;
+
+  // a TTBR0 switch is a synchronisation point for out of sync guest page tables
+  resyncPageTables(context, 0, 0xFFFFFFFF);
+
+  if (((u32int)current->guestPhysical & PT1_ALIGN_MASK) == (ttbr & PT1_ALIGN_MASK))
+  {
+    // same address space, the shadow page tables are kept coherent by pageTableEdit()
+    current->guestPhysical = (simpleEntry *)ttbr;
+    current->lastActive = ++pageTableCacheClock;
+    return;
+  }
+
+  for (i = 0; i < SHADOW_PAGE_TABLE_CACHE_SIZE; i++)
+  {
+    pageTablesVM* entry = &context->pageTableCache[i];
+    if (entry->guestPhysical != NULL
+        && ((u32int)entry->guestPhysical & PT1_ALIGN_MASK) == (ttbr & PT1_ALIGN_MASK))
+    {
+      slot = entry;
+      break;
+    }
+  }
+
+  if (slot != NULL)
+  {
+    DEBUG(MM_ADDRESSING, "switchShadowPageTables: ttbr %#.8x hit slot %p" EOL, ttbr, slot);
+    context->pageTables = slot;
+    slot->guestPhysical = (simpleEntry *)ttbr;
+    slot->contextID = current->contextID;
+    slot->hptInfo = current->hptInfo;
+    slot->lastActive = ++pageTableCacheClock;
+
+    /*
+     * the guest page tables of all cached address spaces are write-protected; catch up with the
+     * writes trapped while this one was switched out, or start over if there were too many.
+     */
+    if (!syncShadowPageTables(context))
+    {
+      DEBUG(MM_ADDRESSING, "switchShadowPageTables: write log overflow, rebuild slot %p" EOL, slot);
+      slot->guestVirtual = NULL;
+      initialiseShadowPageTables(context);
+      return;
+    }
+
+    slot->shadowActive = isGuestInPrivMode(context) ? slot->shadowPriv : slot->shadowUser;
+    mmuDataMemoryBarrier();
+    mmuSetTTBR0(slot->shadowActive, getHostContextID(context, slot->shadowActive));
+    mmuInstructionSync();
+    return;
+  }
+
+  // miss: prefer an unused slot, otherwise evict the least recently used one
+  for (i = 0; i < SHADOW_PAGE_TABLE_CACHE_SIZE; i++)
+  {
+    pageTablesVM* entry = &context->pageTableCache[i];
+    if (entry == current)
+    {
+      continue;
+    }
+    if (entry->guestPhysical == NULL)
+    {
+      slot = entry;
+      break;
+    }
+    if (slot == NULL || entry->lastActive < slot->lastActive)
+    {
+      slot = entry;
+    }
+  }
+  DEBUG(MM_ADDRESSING, "switchShadowPageTables: ttbr %#.8x miss, evict slot %p (gPT %p)" EOL, ttbr,
+        slot, slot->guestPhysical);
+
+  context->pageTables = slot;
+  slot->guestPhysical = (simpleEntry *)ttbr;
+  slot->guestVirtual = NULL;
+  slot->contextID = current->contextID;
+  slot->hptInfo = current->hptInfo;
+  slot->lastActive = ++pageTableCacheClock;
+  slot->writeLogCount = 0;
+  initialiseShadowPageTables(context);
+
+  // the other cached address spaces must not change the new guest 1st lvl page table unseen
+  writeProtectCachedPageTable(context, ttbr & PT1_ALIGN_MASK, PT1_SIZE);
+}
+#endif
+
 /**
  * guest is turning on the MMU. this means, virtual memory is being turned on!
  * lots of work to do!
@@ -196,12 +339,41 @@ void guestDisableMMU(GCONTXT *context)
 
   mmuDisableVirtAddr();
 
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  // drop all cached address spaces but the active one, which is reset below
+  pageTablesVM* current = context->pageTables;
+  u32int i;
+  for (i = 0; i < SHADOW_PAGE_TABLE_CACHE_SIZE; i++)
+  {
+    pageTablesVM* entry = &context->pageTableCache[i];
+    if (entry == current || entry->guestPhysical == NULL)
+    {
+      continue;
+    }
+    context->pageTables = entry;
+    invalidatePageTableInfo(context);
+    free((void *)entry->shadowPriv);
+    free((void *)entry->shadowUser);
+    entry->guestPhysical = NULL;
+    entry->guestVirtual = NULL;
+    entry->shadowPriv = NULL;
+    entry->shadowUser = NULL;
+    entry->shadowActive = NULL;
+    entry->shadowPrivASID = 0;
+    entry->shadowUserASID = 0;
+    entry->writeLogCount = 0;
+  }
+  context->pageTables = current;
+#endif
+
   // reset all the shadow stuff
   context->pageTables->guestPhysical = 0;
   context->pageTables->guestVirtual = 0;
   context->pageTables->shadowPriv = 0;
   context->pageTables->shadowUser = 0;
   context->pageTables->shadowActive = 0;
+  context->pageTables->shadowPrivASID = 0;
+  context->pageTables->shadowUserASID = 0;
   context->pageTables->contextID = 0;
 
   invalidatePageTableInfo(context);
@@ -220,13 +392,14 @@ void guestDisableMMU(GCONTXT *context)
 
   mmuInit();
   mmuSetDomain(HYPERVISOR_ACCESS_DOMAIN, client);
-  mmuSetTTBR0(context->hypervisorPageTable, 0);
+  mmuSetTTBR0(context->hypervisorPageTable, HYPERVISOR_CONTEXT_ID);
 
   // turn vmem back on
   mmuEnableVirtAddr();
   
   // get rid of all translations
   clearTranslationsAll(context->translationStore);
+  invalidateSoftwareTLB(context);
 
   // sync everything to make sure.
   mmuDataMemoryBarrier();
@@ -240,6 +413,10 @@ void guestSetContextID(GCONTXT *context, u32int contextid)
 {
   DEBUG(MM_ADDRESSING, "guestSetContextID: value %x" EOL, contextid);
 
+  if (context->virtAddrEnabled)
+  {
+    resyncPageTables(context, 0, 0xFFFFFFFF);
+  }
   context->pageTables->contextID = (contextid & 0xFF);
 }
 
@@ -270,11 +447,11 @@ void privToUserAddressing(GCONTXT *context)
   //anything in caches needs to be written back now
   mmuDataMemoryBarrier();
 
-  // set translation table base register in the physical MMU!
-  mmuSetTTBR0(context->pageTables->shadowActive, (0x100 | context->pageTables->contextID));
-
-  // clean out all TLB entries - may have conflicting entries
-  mmuInvalidateUTLB();
+  // set translation table base register in the physical MMU! no need to flush the TLB, the shadow
+  // page tables have different ASIDs.
+  mmuSetTTBR0(context->pageTables->shadowActive,
+              getHostContextID(context, context->pageTables->shadowActive));
+  countTLBFlushAvoided(&context->counters);
 
   //just to make sure
   mmuInstructionSync();
@@ -305,16 +482,186 @@ void userToPrivAddressing(GCONTXT *context)
   //anything in caches needs to be written back now
   mmuDataMemoryBarrier();
 
-  // set translation table base register in the physical MMU!
-  mmuSetTTBR0(context->pageTables->shadowActive, (0x100 | context->pageTables->contextID));
-
-  // clean out all TLB entries - may have conflicting entries
-  mmuInvalidateUTLB();
+  // set translation table base register in the physical MMU! no need to flush the TLB, the shadow
+  // page tables have different ASIDs.
+  mmuSetTTBR0(context->pageTables->shadowActive,
+              getHostContextID(context, context->pageTables->shadowActive));
+  countTLBFlushAvoided(&context->counters);
 
   //just to make sure
   mmuInstructionSync();
 }
 
+
+static u32int allocateASID(GCONTXT *context)
+{
+  if (nextASID > ASID_LAST)
+  {
+    DEBUG(MM_ADDRESSING, "allocateASID: ASID rollover, generation %#x" EOL, asidGeneration);
+    asidGeneration += 1 << ASID_BITS;
+    nextASID = ASID_FIRST;
+    // the active ASID may be handed out again; switch to the reserved one before flushing
+    mmuSetContextID(0);
+    mmuInstructionSync();
+    mmuInvalidateUTLB();
+    countASIDRollover(&context->counters);
+  }
+  return asidGeneration | nextASID++;
+}
+
+
+/*
+ * Returns the hardware ASID for a shadow page table, allocating a new one if the page table does
+ * not have an ASID of the current generation.
+ */
+static u32int getASID(GCONTXT *context, u32int *asid)
+{
+  if ((*asid & ~ASID_MASK) != asidGeneration)
+  {
+    *asid = allocateASID(context);
+    DEBUG(MM_ADDRESSING, "getASID: allocated ASID %#x" EOL, *asid & ASID_MASK);
+  }
+  return *asid & ASID_MASK;
+}
+
+
+/*
+ * Returns the hardware ASID TLB entries loaded from a page table are tagged with, or ASID_NONE if
+ * there cannot be any such entries.
+ */
+static u32int lookupASID(GCONTXT *context, simpleEntry *pageTable)
+{
+  u32int asid;
+  if (pageTable == context->pageTables->shadowPriv)
+  {
+    asid = context->pageTables->shadowPrivASID;
+  }
+  else if (pageTable == context->pageTables->shadowUser)
+  {
+    asid = context->pageTables->shadowUserASID;
+  }
+  else
+  {
+    return HYPERVISOR_CONTEXT_ID & ASID_MASK;
+  }
+  return ((asid & ~ASID_MASK) == asidGeneration) ? (asid & ASID_MASK) : ASID_NONE;
+}
+
+
+/**
+ * returns the value for the context ID register to be used with a page table
+ **/
+u32int getHostContextID(GCONTXT *context, simpleEntry *pageTable)
+{
+  if (pageTable == context->pageTables->shadowPriv)
+  {
+    return 0x100 | getASID(context, &context->pageTables->shadowPrivASID);
+  }
+  if (pageTable == context->pageTables->shadowUser)
+  {
+    return 0x100 | getASID(context, &context->pageTables->shadowUserASID);
+  }
+  return HYPERVISOR_CONTEXT_ID;
+}
+
+
+/**
+ * invalidates TLB entries for a virtual address loaded from the given page table
+ * (and global entries for that address)
+ **/
+void invalidateTLBbyMVA(GCONTXT *context, simpleEntry *pageTable, u32int virtAddr)
+{
+  u32int asid = lookupASID(context, pageTable);
+  if (asid == ASID_NONE)
+  {
+    asid = 0;
+  }
+  mmuInvalidateUTLBbyMVA((virtAddr & SMALL_PAGE_MASK) | asid);
+}
+
+
+/**
+ * invalidates TLB entries for a virtual address loaded from either shadow page table
+ **/
+void invalidateShadowTLBbyMVA(GCONTXT *context, u32int virtAddr)
+{
+  invalidateTLBbyMVA(context, context->pageTables->shadowPriv, virtAddr);
+  invalidateTLBbyMVA(context, context->pageTables->shadowUser, virtAddr);
+  invalidateSoftwareTLBRange(context, virtAddr, virtAddr);
+}
+
+
+/**
+ * invalidates all TLB entries loaded from the shadow page tables
+ **/
+void invalidateShadowTLB(GCONTXT *context)
+{
+  u32int asid = lookupASID(context, context->pageTables->shadowPriv);
+  if (asid != ASID_NONE)
+  {
+    mmuInvalidateITLBbyASID(asid);
+    mmuInvalidateDTLBbyASID(asid);
+  }
+  asid = lookupASID(context, context->pageTables->shadowUser);
+  if (asid != ASID_NONE)
+  {
+    mmuInvalidateITLBbyASID(asid);
+    mmuInvalidateDTLBbyASID(asid);
+  }
+  invalidateSoftwareTLB(context);
+}
+
+
+#ifdef CONFIG_SOFTWARE_TLB
+/**
+ * drops all translations cached by getPhysicalAddress()
+ **/
+void invalidateSoftwareTLB(GCONTXT *context)
+{
+  memset(context->softwareTLB, 0, sizeof(context->softwareTLB));
+}
+
+
+/**
+ * drops translations cached by getPhysicalAddress() for virtual addresses in a range,
+ * whichever page table they were loaded from
+ **/
+void invalidateSoftwareTLBRange(GCONTXT *context, u32int startAddr, u32int endAddr)
+{
+  u32int startPage = startAddr & SMALL_PAGE_MASK;
+  u32int endPage = endAddr & SMALL_PAGE_MASK;
+  u32int i;
+
+  if ((endPage - startPage) / SMALL_PAGE_SIZE < SOFTWARE_TLB_ENTRIES)
+  {
+    // few pages: only look at the entries they map to
+    u32int page = startPage;
+    do
+    {
+      struct SoftwareTLBEntry *entry =
+        &context->softwareTLB[(page / SMALL_PAGE_SIZE) % SOFTWARE_TLB_ENTRIES];
+      if (entry->pageTable != NULL && entry->virtualPage == page)
+      {
+        entry->pageTable = NULL;
+      }
+      page += SMALL_PAGE_SIZE;
+    }
+    while (page != endPage + SMALL_PAGE_SIZE);
+    return;
+  }
+
+  for (i = 0; i < SOFTWARE_TLB_ENTRIES; i++)
+  {
+    struct SoftwareTLBEntry *entry = &context->softwareTLB[i];
+    if (entry->pageTable != NULL && entry->virtualPage >= startPage && entry->virtualPage <= endPage)
+    {
+      entry->pageTable = NULL;
+    }
+  }
+}
+#endif
+
+
 /**
  * allocate and set up double shadow page tables for the guest
  **/
@@ -326,6 +673,7 @@ void initialiseShadowPageTables(GCONTXT *gc)
   mmuDataMemoryBarrier();
 
   invalidatePageTableInfo(gc);
+  invalidateSoftwareTLB(gc);
 
   DEBUG(MM_ADDRESSING, "initialiseShadowPageTables: invalidatePageTableInfo() done." EOL);
 
@@ -349,11 +697,13 @@ void initialiseShadowPageTables(GCONTXT *gc)
   //anything in caches needs to be written back now
   mmuDataMemoryBarrier();
 
-  // set translation table base register in the physical MMU!
-  mmuSetTTBR0(gc->pageTables->shadowActive, (0x100 | gc->pageTables->contextID));
+  // the new shadow page tables get new ASIDs; TLB entries of the old ones can no longer be hit.
+  gc->pageTables->shadowPrivASID = 0;
+  gc->pageTables->shadowUserASID = 0;
 
-  // clean out all TLB entries - may have conflicting entries
-  mmuInvalidateUTLB();
+  // set translation table base register in the physical MMU!
+  mmuSetTTBR0(gc->pageTables->shadowActive, getHostContextID(gc, gc->pageTables->shadowActive));
+  countTLBFlushAvoided(&gc->counters);
 
   //just to make sure
   mmuInstructionSync();
@@ -9,6 +9,13 @@
 #include "memoryManager/memoryProtection.h"
 
 
+/*
+ * Value of the context ID register while the hypervisor page table is in use. The hypervisor
+ * page table uses ASID 0xFF; ASID 0 is used while switching page tables (see mmuSetTTBR0()).
+ */
+#define HYPERVISOR_CONTEXT_ID  0x1FF
+
+
 /* Need to initialise the MMU and enable virtual addressing */
 void initVirtualAddressing(GCONTXT *context) __cold__;
 
@@ -24,6 +31,19 @@ void guestSetContextID(GCONTXT *context, u32int contextid);
 void privToUserAddressing(GCONTXT *context);
 void userToPrivAddressing(GCONTXT *context);
 
+u32int getHostContextID(GCONTXT *context, simpleEntry *pageTable);
+void invalidateTLBbyMVA(GCONTXT *context, simpleEntry *pageTable, u32int virtAddr);
+void invalidateShadowTLBbyMVA(GCONTXT *context, u32int virtAddr);
+void invalidateShadowTLB(GCONTXT *context);
+
+#ifdef CONFIG_SOFTWARE_TLB
+void invalidateSoftwareTLB(GCONTXT *context);
+void invalidateSoftwareTLBRange(GCONTXT *context, u32int startAddr, u32int endAddr);
+#else
+#define invalidateSoftwareTLB(context)
+#define invalidateSoftwareTLBRange(context, startAddr, endAddr)
+#endif
+
 void initialiseShadowPageTables(GCONTXT *gc);
 
 void changeGuestDACR(GCONTXT *context, DACR oldVal, DACR newVal);
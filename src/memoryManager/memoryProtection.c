@@ -5,6 +5,7 @@
 #include "guestManager/guestContext.h"
 #include "guestManager/guestExceptions.h"
 
+#include "memoryManager/addressing.h"
 #include "memoryManager/memoryConstants.h"
 #include "memoryManager/memoryProtection.h"
 #include "memoryManager/mmu.h"
@@ -65,6 +66,7 @@ void writeProtectRange(GCONTXT *gc, simpleEntry* pageTable, u32int start, u32int
       {
         // split section up to small pages, so we protect the least amount of space 
         splitSectionToSmallPages(pageTable, start);
+        invalidateTLBbyMVA(gc, pageTable, start);
         // now its PAGE_TABLE type, fall through...
       }
       case PAGE_TABLE:
@@ -99,7 +101,7 @@ void writeProtectRange(GCONTXT *gc, simpleEntry* pageTable, u32int start, u32int
         {
           entry->ap10 = PRIV_RW_USR_RO & 0x3;
           entry->ap2 = PRIV_RW_USR_RO >> 2; 
-          mmuInvalidateUTLBbyMVA(pageStartAddress);
+          invalidateTLBbyMVA(gc, pageTable, pageStartAddress);
         }
         pageEndAddress = (pageStartAddress & 0xFFFFF000) + (SMALL_PAGE_SIZE - 1);
         break;
@@ -205,7 +207,7 @@ bool shouldDataAbort(GCONTXT *context, bool privAccess, bool isWrite, u32int add
 
   if (returnValue)
   {
-    mmuSetTTBR0(ttbrBackup, 0x100 | context->pageTables->contextID);
+    mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
     return returnValue;
   }
 
@@ -351,7 +353,7 @@ bool shouldDataAbort(GCONTXT *context, bool privAccess, bool isWrite, u32int add
     } // case CLIENT ends
   } // switch domain bits ends
 
-  mmuSetTTBR0(ttbrBackup, 0x100 | context->pageTables->contextID);
+  mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
   return returnValue;
 }
 
@@ -436,7 +438,7 @@ bool shouldPrefetchAbort(GCONTXT *context, bool privAccess, u32int address)
   // if we are prefetch aborting with Translation Fault, return already, exception thrown.
   if (returnValue)
   {
-    mmuSetTTBR0(ttbrBackup, 0x100 | context->pageTables->contextID);
+    mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
     return returnValue;
   }
 
@@ -554,6 +556,6 @@ bool shouldPrefetchAbort(GCONTXT *context, bool privAccess, u32int address)
     } // DACR client case ends
   } // switch domBits ends
 
-  mmuSetTTBR0(ttbrBackup, 0x100 | context->pageTables->contextID);
+  mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
   return returnValue;
 }
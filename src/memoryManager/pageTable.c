@@ -66,40 +66,7 @@ void deleteLevelTwoPageTable(GCONTXT *context, pageTableEntry *pageTable)
   DEBUG(MM_PAGE_TABLES, "deleteLevelTwoPageTable: page table entry %#.8x @ %p" EOL,
         *(u32int *)pageTable, pageTable);
   // this can only be called on shadow second level page tables
-  ptInfo *head = context->pageTables->sptInfo;
-  ptInfo *prev = 0;
-  while (head != NULL)
-  {
-    if ((head->firstLevelEntry == pageTable) && (*(u32int *)head->firstLevelEntry == *(u32int *)pageTable))
-    {
-      head->firstLevelEntry = NULL;
-      head->physAddr = 0;
-      free((void *)head->virtAddr);
-      head->virtAddr = 0;
-      
-      // remember a pointer to this doomed entry
-      ptInfo *tempPtr = head;
-      head = head->nextEntry;
-      free(tempPtr);
-      
-      // all thats left is to link previous entry to next entry (if there was a previous entry!)
-      if (prev != NULL)
-      {
-        prev->nextEntry = head;
-      }
-      else
-      {
-        // removing first entry from the list
-        context->pageTables->sptInfo = head;
-      }
-      return;
-    }
-    else
-    {
-      prev = head;
-      head = head->nextEntry;
-    }
-  } // while ends
+  removePageTableInfo(context, pageTable, TRUE);
 }
 
 
@@ -590,6 +557,39 @@ void addLargePageEntry(largePageEntry *entry, u32int physical, u8int accessBits,
 }
 
 
+/**
+ * marks all mappings of a virtual address range in a page table as non-global,
+ * so that TLB entries loaded from them are tagged with the current ASID
+ **/
+void setNonGlobal(GCONTXT *context, simpleEntry *pageTable, u32int startAddress, u32int endAddress)
+{
+  DEBUG(MM_PAGE_TABLES, "setNonGlobal: PT %p from %#.8x to %#.8x" EOL, pageTable, startAddress,
+        endAddress);
+
+  u32int address = startAddress;
+  while (address < endAddress)
+  {
+    simpleEntry* entry = getEntryFirst(pageTable, address);
+    if (entry->type == SECTION)
+    {
+      ((sectionEntry *)entry)->nG = 1;
+    }
+    else if (entry->type == PAGE_TABLE)
+    {
+      simpleEntry* page = getEntrySecond(context, (pageTableEntry *)entry, address);
+      if (page->type != FAULT)
+      {
+        // large and small pages keep the nG bit in the same place
+        ((smallPageEntry *)page)->nG = 1;
+      }
+      address += SMALL_PAGE_SIZE;
+      continue;
+    }
+    address = (address & SECTION_MASK) + SECTION_SIZE;
+  }
+}
+
+
 /**
  * Allocates memory for a new second level page table
  * adds a new page table entry to a given place in a base page table
@@ -608,12 +608,41 @@ void addPageTableEntry(pageTableEntry* pageTableEntryPtr, u32int physical, u8int
 }
 
 
+#ifdef CONFIG_SOFTWARE_TLB
+/**
+ * enters a translation found by getPhysicalAddress() in the software TLB
+ **/
+static inline u32int cacheTranslation(GCONTXT *context, simpleEntry* pageTable, u32int virtAddr,
+                                      u32int physAddr)
+{
+  struct SoftwareTLBEntry *entry =
+    &context->softwareTLB[(virtAddr / SMALL_PAGE_SIZE) % SOFTWARE_TLB_ENTRIES];
+  entry->pageTable = pageTable;
+  entry->virtualPage = virtAddr & SMALL_PAGE_MASK;
+  entry->physicalPage = physAddr & SMALL_PAGE_MASK;
+  return physAddr;
+}
+#else
+#define cacheTranslation(context, pageTable, virtAddr, physAddr)  (physAddr)
+#endif
+
+
 /**
  * Given a virtual address, retrieves the underlying physical address
  **/
 u32int getPhysicalAddress(GCONTXT *context, simpleEntry* pageTable, u32int virtAddr)
 {
   DEBUG(MM_PAGE_TABLES, "getPhysicalAddress for VA %#.8x in PT @ %p" EOL, virtAddr, pageTable);
+#ifdef CONFIG_SOFTWARE_TLB
+  struct SoftwareTLBEntry *cached =
+    &context->softwareTLB[(virtAddr / SMALL_PAGE_SIZE) % SOFTWARE_TLB_ENTRIES];
+  if (cached->pageTable == pageTable && cached->virtualPage == (virtAddr & SMALL_PAGE_MASK))
+  {
+    countSoftwareTLBHit(&context->counters);
+    return cached->physicalPage | (virtAddr & ~SMALL_PAGE_MASK);
+  }
+  countSoftwareTLBMiss(&context->counters);
+#endif
   simpleEntry* entryFirst = getEntryFirst(pageTable, virtAddr);
   if (entryFirst->type == FAULT)
   {
@@ -642,7 +671,8 @@ u32int getPhysicalAddress(GCONTXT *context, simpleEntry* pageTable, u32int virtA
       }
       else
       {
-        return (section->addr << 20) | (virtAddr & ~SECTION_MASK);
+        return cacheTranslation(context, pageTable, virtAddr,
+                                (section->addr << 20) | (virtAddr & ~SECTION_MASK));
       }
       break;
     }
@@ -664,13 +694,15 @@ u32int getPhysicalAddress(GCONTXT *context, simpleEntry* pageTable, u32int virtA
         case LARGE_PAGE:
         {
           largePageEntry *largePage = (largePageEntry *)entrySecond;
-          return (largePage->addr << 16) | (virtAddr & ~LARGE_PAGE_MASK);
+          return cacheTranslation(context, pageTable, virtAddr,
+                                  (largePage->addr << 16) | (virtAddr & ~LARGE_PAGE_MASK));
         }
         case SMALL_PAGE: //fall through
         case SMALL_PAGE_3:
         {
           smallPageEntry* smallPage = (smallPageEntry*)entrySecond;
-          return (smallPage->addr << 12) | (virtAddr & ~SMALL_PAGE_MASK);
+          return cacheTranslation(context, pageTable, virtAddr,
+                                  (smallPage->addr << 12) | (virtAddr & ~SMALL_PAGE_MASK));
         }
         default:
         {
@@ -772,6 +804,7 @@ void splitSectionToSmallPages(simpleEntry* pageTable, u32int virtAddr)
   u16int b = sectionEntryPtr->b;
   u16int tex = sectionEntryPtr->tex;
   u16int xn = sectionEntryPtr->xn;
+  bool nonGlobal = sectionEntryPtr->nG;
 
   // 3. map memory in small pages
   virtAddr = virtAddr & 0xFFF00000;
@@ -786,6 +819,10 @@ void splitSectionToSmallPages(simpleEntry* pageTable, u32int virtAddr)
     mapSmallPage(pageTable, virtAddr + (SMALL_PAGE_SIZE * index),
        physAddr + (SMALL_PAGE_SIZE * index), domain, protectionBits, c, b, tex, xn);
   }
+  if (nonGlobal)
+  {
+    setNonGlobal(getActiveGuestContext(), pageTable, virtAddr, virtAddr + SECTION_SIZE);
+  }
 }
 
 
@@ -894,6 +931,8 @@ void pageTableEdit(GCONTXT *context, u32int address, u32int newVal)
     virtualAddress |= ((address & 0x3FC) << 10);
     DEBUG(MM_PAGE_TABLES, "pageTableEdit: PT2 case: pt edit corresponds to VA %#.8x" EOL,
           virtualAddress);
+
+    trackPageTableWrite(context, head, address, newVal);
   }
 
 
@@ -1055,6 +1094,14 @@ void pageTableEdit(GCONTXT *context, u32int address, u32int newVal)
   } // editing entry attributes ends
 //  mmuClearTLBbyMVA(address);
   mmuInvalidateUTLB();
+  if (firstLevelEntry)
+  {
+    invalidateSoftwareTLBRange(context, virtualAddress, virtualAddress + SECTION_SIZE - 1);
+  }
+  else
+  {
+    invalidateSoftwareTLBRange(context, virtualAddress, virtualAddress);
+  }
   mmuClearDataCache();
   mmuDataMemoryBarrier();
 }
@@ -167,6 +167,8 @@ void addLargePageEntry(largePageEntry *entry, u32int physical, u8int accessBits,
                        bool bufferable, u8int tex, bool executeNever);
 void addPageTableEntry(pageTableEntry* pageTableEntryPtr, u32int physical, u8int domain);
 
+void setNonGlobal(GCONTXT *context, simpleEntry *pageTable, u32int startAddress, u32int endAddress);
+
 u32int getPhysicalAddress(GCONTXT *context, simpleEntry* pageTable, u32int virtAddr);
 simpleEntry* getEntryFirst(simpleEntry* pageTable, u32int virtAddr);
 simpleEntry* getEntrySecond(GCONTXT *context, pageTableEntry* firstLevelEntry, u32int virtAddr);
@@ -1,54 +1,128 @@
 #include "common/debug.h"
 #include "common/stdlib.h"
+#include "common/string.h"
 
 #include "guestManager/guestContext.h"
 
 #include "memoryManager/pageTableInfo.h"
 
 
+/*
+ * shadow and guest page table metadata is looked up by the address of the 1st lvl entry that
+ * points to the 2nd lvl page table. entries are hashed on the 1st lvl page table index of that
+ * address, so each bucket only holds the few entries for the same megabyte (shadow priv and user,
+ * guest). the sptInfo and gptInfo lists are kept for walking all entries.
+ * hypervisor metadata is only added before the guest enables its MMU and is not indexed.
+ */
+#define PT_INFO_INDEX(entry)  ((((u32int)(entry)) >> 2) & (PT1_ENTRIES - 1))
+
+/* metadata entries are allocated in chunks and recycled through a free list */
+#define PT_INFO_POOL_CHUNK    64
+
+
+static ptInfo *ptInfoPool = NULL;
+
+
+static ptInfo *allocatePageTableInfo(GCONTXT *context);
+static void releasePageTableInfo(ptInfo *entry);
+static void pushPageTableInfo(ptInfo **headPtr, ptInfo *entry);
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+static void removeUnsyncedPageTableInfo(GCONTXT *context, ptInfo *entry);
+#endif
+
+
+static ptInfo *allocatePageTableInfo(GCONTXT *context)
+{
+  if (ptInfoPool == NULL)
+  {
+    ptInfo *chunk = (ptInfo *)calloc(PT_INFO_POOL_CHUNK, sizeof(ptInfo));
+    if (chunk == NULL)
+    {
+      DIE_NOW(context, "allocatePageTableInfo: out of memory");
+    }
+    u32int i;
+    for (i = 0; i < PT_INFO_POOL_CHUNK; i++)
+    {
+      releasePageTableInfo(&chunk[i]);
+    }
+  }
+
+  ptInfo *entry = ptInfoPool;
+  ptInfoPool = entry->nextEntry;
+  memset(entry, 0, sizeof(ptInfo));
+  return entry;
+}
+
+
+static void releasePageTableInfo(ptInfo *entry)
+{
+  entry->nextEntry = ptInfoPool;
+  ptInfoPool = entry;
+}
+
+
+static void pushPageTableInfo(ptInfo **headPtr, ptInfo *entry)
+{
+  entry->prevEntry = NULL;
+  entry->nextEntry = *headPtr;
+  if (*headPtr != NULL)
+  {
+    (*headPtr)->prevEntry = entry;
+  }
+  *headPtr = entry;
+}
+
+
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+static void removeUnsyncedPageTableInfo(GCONTXT *context, ptInfo *entry)
+{
+  ptInfo **link = &context->pageTables->unsyncedInfo;
+  while (*link != NULL)
+  {
+    if (*link == entry)
+    {
+      *link = entry->nextUnsynced;
+      return;
+    }
+    link = &(*link)->nextUnsynced;
+  }
+}
+#endif
+
+
 void addPageTableInfo(GCONTXT *context, pageTableEntry* entry, u32int virtual, u32int physical, u32int mapped, bool host)
 {
   DEBUG(MM_PAGE_TABLES, "addPageTableInfo: entry %#.8x @ %p, PA %#.8x VA %#.8x, mapped %#.8x host %x" EOL,
         *(u32int *)entry, entry, physical, virtual, mapped, host);
 
-  ptInfo *newEntry = (ptInfo *)calloc(1, sizeof(ptInfo));
+  ptInfo *newEntry = allocatePageTableInfo(context);
   DEBUG(MM_PAGE_TABLES, "addPageTableInfo: new entry @ %p" EOL, newEntry);
   newEntry->firstLevelEntry = entry;
   newEntry->physAddr = physical;
   newEntry->virtAddr = virtual;
   newEntry->host = host;
   newEntry->mappedMegabyte = mapped;
-  newEntry->nextEntry = 0;
 
-
-  ptInfo** headPtr;
   if (!context->virtAddrEnabled)
   {
     // virtual addressing is not enabled yet. this metadata has a special place
-    headPtr = &context->pageTables->hptInfo;
-  }
-  else
-  {
-    headPtr = (host) ? &context->pageTables->sptInfo : &context->pageTables->gptInfo;
+    pushPageTableInfo(&context->pageTables->hptInfo, newEntry);
+    return;
   }
 
-  if (*headPtr == NULL)
-  {
-    // first entry. just set head to newEntry;
-    *headPtr = newEntry;
-  }
-  else
+  pushPageTableInfo((host) ? &context->pageTables->sptInfo : &context->pageTables->gptInfo, newEntry);
+
+  if (context->pageTables->ptInfoIndex == NULL)
   {
-    // loop to the end of the list
-    ptInfo* head = *headPtr;
-    while (head->nextEntry != NULL)
+    context->pageTables->ptInfoIndex = (ptInfo **)calloc(PT1_ENTRIES, sizeof(ptInfo *));
+    if (context->pageTables->ptInfoIndex == NULL)
     {
-      head = head->nextEntry;
+      DIE_NOW(context, "addPageTableInfo: failed to allocate index");
     }
-    head->nextEntry = newEntry;
   }
-  dumpPageTableInfo(context);
-  // done.
+  ptInfo **bucket = &context->pageTables->ptInfoIndex[PT_INFO_INDEX(entry)];
+  newEntry->nextInIndex = *bucket;
+  *bucket = newEntry;
 }
 
 
@@ -57,39 +131,29 @@ ptInfo *getPageTableInfo(GCONTXT *context, pageTableEntry *firstLevelEntry)
   DEBUG(MM_PAGE_TABLES, "getPageTableInfo: first level entry ptr %p = %#.8x" EOL, firstLevelEntry,
         *(u32int *)firstLevelEntry);
 
-  // hpt first
-  ptInfo *head = context->pageTables->hptInfo;
-  while (head != NULL)
+  ptInfo *head;
+  if (context->pageTables->ptInfoIndex != NULL)
   {
-    if (head->firstLevelEntry == firstLevelEntry)
+    head = context->pageTables->ptInfoIndex[PT_INFO_INDEX(firstLevelEntry)];
+    while (head != NULL)
     {
-      DEBUG(MM_PAGE_TABLES, "getPageTableInfo: found spt; entry %p = %#.8x" EOL,
-            head->firstLevelEntry, *(u32int *)head->firstLevelEntry);
-      return head;
-    }
-    head = head->nextEntry;
-  }
-
-  // spt first
-  head = context->pageTables->sptInfo;
-  while (head != NULL)
-  {
-    if (head->firstLevelEntry == firstLevelEntry)
-    {
-      DEBUG(MM_PAGE_TABLES, "getPageTableInfo: found spt; entry %p = %#.8x" EOL,
-            head->firstLevelEntry, *(u32int *)head->firstLevelEntry);
-      return head;
+      if (head->firstLevelEntry == firstLevelEntry)
+      {
+        DEBUG(MM_PAGE_TABLES, "getPageTableInfo: found %s; entry %p = %#.8x" EOL,
+              head->host ? "spt" : "gpt", head->firstLevelEntry, *(u32int *)head->firstLevelEntry);
+        return head;
+      }
+      head = head->nextInIndex;
     }
-    head = head->nextEntry;
   }
 
-  // its not spt, gpt then?
-  head = context->pageTables->gptInfo;
+  // hpt then
+  head = context->pageTables->hptInfo;
   while (head != NULL)
   {
     if (head->firstLevelEntry == firstLevelEntry)
     {
-      DEBUG(MM_PAGE_TABLES, "getPageTableInfo: found gpt; entry %p = %#.8x" EOL,
+      DEBUG(MM_PAGE_TABLES, "getPageTableInfo: found hpt; entry %p = %#.8x" EOL,
             head->firstLevelEntry, *(u32int *)head->firstLevelEntry);
       return head;
     }
@@ -106,44 +170,56 @@ void removePageTableInfo(GCONTXT *context, pageTableEntry* firstLevelEntry, bool
   DEBUG(MM_PAGE_TABLES, "removePageTableInfo: first level entry ptr %p = %#.8x" EOL,
         firstLevelEntry, *(u32int *)firstLevelEntry);
 
-  ptInfo *head = (host) ? context->pageTables->sptInfo : context->pageTables->gptInfo;
-  ptInfo *prev = NULL;
+  if (context->pageTables->ptInfoIndex == NULL)
+  {
+    return;
+  }
 
-  while (head != NULL)
+  ptInfo **link = &context->pageTables->ptInfoIndex[PT_INFO_INDEX(firstLevelEntry)];
+  while (*link != NULL)
   {
-    if (head->firstLevelEntry == firstLevelEntry)
+    ptInfo *head = *link;
+    if (head->firstLevelEntry == firstLevelEntry && head->host == host)
     {
       DEBUG(MM_PAGE_TABLES, "removePageTableInfo: found entry %p = %#.8x" EOL,
             head->firstLevelEntry, *(u32int *)head->firstLevelEntry);
-      ptInfo* tmp = head;
-      head = head->nextEntry;
-      if (host)
+      *link = head->nextInIndex;
+
+      if (head->prevEntry != NULL)
       {
-        free((void *)tmp->virtAddr);
+        head->prevEntry->nextEntry = head->nextEntry;
       }
-
-      if (prev == 0)
+      else if (host)
       {
-        // first entry in list.
-        if (host)
-        {
-          context->pageTables->sptInfo = head;
-        }
-        else
-        {
-          context->pageTables->gptInfo = head;
-        }
+        context->pageTables->sptInfo = head->nextEntry;
       }
       else
       {
-        // not the first entry in list
-        prev->nextEntry = head;
+        context->pageTables->gptInfo = head->nextEntry;
+      }
+      if (head->nextEntry != NULL)
+      {
+        head->nextEntry->prevEntry = head->prevEntry;
       }
-      free(tmp);
+
+      if (host)
+      {
+        free((void *)head->virtAddr);
+      }
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+      if (head->outOfSync)
+      {
+        removeUnsyncedPageTableInfo(context, head);
+      }
+      if (head->snapshot != NULL)
+      {
+        free(head->snapshot);
+      }
+#endif
+      releasePageTableInfo(head);
       return;
     }
-    prev = head;
-    head = head->nextEntry;
+    link = &head->nextInIndex;
   }
 }
 
@@ -153,8 +229,17 @@ void dumpPageTableInfo(GCONTXT *context)
 #if CONFIG_DEBUG_MM_PAGE_TABLES
   printf("dumpPageTableInfo:" EOL);
 
-  // spt first
-  ptInfo* head = context->pageTables->sptInfo;
+  // hpt first
+  ptInfo* head = context->pageTables->hptInfo;
+  printf("hptInfo:" EOL);
+  while (head != 0)
+  {
+    printf("%p: ptEntry %p; PA %#.8x VA %#.8x host %x" EOL, head, head->firstLevelEntry, head->physAddr, head->virtAddr, head->host);
+    head = head->nextEntry;
+  }
+
+  // spt then
+  head = context->pageTables->sptInfo;
   printf("sptInfo:" EOL);
   while (head != 0)
   {
@@ -162,7 +247,7 @@ void dumpPageTableInfo(GCONTXT *context)
     head = head->nextEntry;
   }
 
-  // gpt then
+  // gpt last
   head = context->pageTables->gptInfo;
   printf("gptInfo:" EOL);
   while (head != 0)
@@ -184,7 +269,7 @@ void invalidatePageTableInfo(GCONTXT *context)
 
     ptInfo* tempPtr = context->pageTables->sptInfo;
     context->pageTables->sptInfo = context->pageTables->sptInfo->nextEntry;
-    free(tempPtr);
+    releasePageTableInfo(tempPtr);
   }
 
   // gpt then
@@ -192,7 +277,22 @@ void invalidatePageTableInfo(GCONTXT *context)
   {
     ptInfo *tempPtr = context->pageTables->gptInfo;
     context->pageTables->gptInfo = context->pageTables->gptInfo->nextEntry;
-    free(tempPtr);
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+    if (tempPtr->snapshot != NULL)
+    {
+      free(tempPtr->snapshot);
+    }
+#endif
+    releasePageTableInfo(tempPtr);
+  }
+
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+  context->pageTables->unsyncedInfo = NULL;
+#endif
+
+  if (context->pageTables->ptInfoIndex != NULL)
+  {
+    memset(context->pageTables->ptInfoIndex, 0, PT1_ENTRIES * sizeof(ptInfo *));
   }
 
   DEBUG(MM_PAGE_TABLES, "invalidatePageTableInfo: ...done" EOL);
@@ -16,7 +16,20 @@ struct PageTableMetaData
   u32int physAddr;
   u32int mappedMegabyte;
   bool host;
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+  /* copy of a guest 2nd lvl page table, see unsyncPageTables() */
+  u32int *snapshot;
+  /* trapped writes to a guest 2nd lvl page table, see trackPageTableWrite(), resyncPageTables() */
+  u32int writeCount;
+  bool outOfSync;
+  /* virtual address at which the page holding the table was made writable by unsyncPageTables() */
+  u32int unsyncedVirtual;
+  struct PageTableMetaData *nextUnsynced;
+#endif
   struct PageTableMetaData *nextEntry;
+  struct PageTableMetaData *prevEntry;
+  /* next entry with the same 1st lvl page table index */
+  struct PageTableMetaData *nextInIndex;
 };
 typedef struct PageTableMetaData ptInfo;
 
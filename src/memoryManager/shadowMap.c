@@ -7,12 +7,41 @@
 #include "guestManager/guestContext.h"
 #include "guestManager/translationStore.h"
 
+#include "memoryManager/addressing.h"
 #include "memoryManager/memoryConstants.h"
 #include "memoryManager/memoryProtection.h"
 #include "memoryManager/mmu.h"
 #include "memoryManager/shadowMap.h"
 
 
+#if CONFIG_SHADOW_FAULT_AROUND > 1
+static void shadowMapAround(GCONTXT *context, pageTableEntry* guestFirst, pageTableEntry* shadowFirst,
+                            u32int virtAddr);
+static bool isFaultAroundCandidate(GCONTXT *context, u32int guestPhysical);
+#endif
+#ifndef CONFIG_HW_PASSTHROUGH
+static void mapDirectReadPages(GCONTXT *context, sectionEntry* guest, sectionEntry* shadow, u32int virtual);
+#endif
+static void writeProtectGuestPageTable(GCONTXT *context, u32int gptPhysical, u32int size);
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+static bool isInPageTables(pageTablesVM* pageTables, u32int physical, u32int size);
+static bool isCachedPageTable(GCONTXT *context, u32int physical, u32int size);
+static void writeProtectCachedTablesInSection(GCONTXT *context, u32int guestPhysical,
+                                              u32int virtual);
+#endif
+#if defined(CONFIG_SHADOW_PAGE_TABLE_CACHE) || CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+static void syncUnmapSmallPage(GCONTXT *context, simpleEntry* shadowTable, smallPageEntry* guest,
+                               u32int virtual);
+#endif
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+static bool syncPageTable(GCONTXT *context, ptInfo* metadata, u32int virtual);
+static void unsyncPageTables(GCONTXT *context, u32int physical, u32int virtual);
+static bool isQuietPageTablePage(GCONTXT *context, u32int physical, u32int startAddress,
+                                 u32int endAddress);
+static void reprotectPageTables(GCONTXT *context, u32int physical, u32int virtual);
+#endif
+
+
 /**
  * take a VA that caused a memory abort and try to add a shadow mapping
  * from the guest page table to both shadow page tables 
@@ -107,6 +136,10 @@ bool shadowMap(GCONTXT *context, u32int virtAddr)
           smallPageEntry* shadowSmallPage = (smallPageEntry*)getEntrySecond(context, (pageTableEntry*)shadowFirst, virtAddr);
           shadowMapSmallPage(context, guestSmallPage, shadowSmallPage, ((pageTableEntry*)guestFirst)->domain);
           mmuPageTableEdit((u32int)shadowSmallPage, (virtAddr & SMALL_PAGE_MASK));
+          countShadowPageFault(&context->counters);
+#if CONFIG_SHADOW_FAULT_AROUND > 1
+          shadowMapAround(context, (pageTableEntry*)guestFirst, (pageTableEntry*)shadowFirst, virtAddr);
+#endif
           success = TRUE;
           break;
         }
@@ -138,11 +171,82 @@ bool shadowMap(GCONTXT *context, u32int virtAddr)
     }
   }
 
-  mmuSetTTBR0(ttbrBackup, 0x100 | context->pageTables->contextID);
+  mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
   return success;
 }
 
 
+#if CONFIG_SHADOW_FAULT_AROUND > 1
+/**
+ * shadow maps the valid neighbours of a faulting guest small page from the same guest 2nd lvl
+ * page table, in an aligned window of CONFIG_SHADOW_FAULT_AROUND pages. the guest tends to touch
+ * them next, and this saves the exception and page table switch of a fault for each of them.
+ **/
+static void shadowMapAround(GCONTXT *context, pageTableEntry* guestFirst, pageTableEntry* shadowFirst,
+                            u32int virtAddr)
+{
+  u32int gptPhysAddr = guestFirst->addr << 10;
+  u32int faultIndex = (virtAddr & ~SECTION_MASK) >> 12;
+  u32int index = faultIndex - (faultIndex % CONFIG_SHADOW_FAULT_AROUND);
+  u32int lastIndex = index + CONFIG_SHADOW_FAULT_AROUND;
+  if (lastIndex > PT2_ENTRIES)
+  {
+    lastIndex = PT2_ENTRIES;
+  }
+
+  for (; index < lastIndex; index++)
+  {
+    simpleEntry* guestSecond = (simpleEntry *)(gptPhysAddr | (index << 2));
+    if ((index == faultIndex) || (guestSecond->type != SMALL_PAGE && guestSecond->type != SMALL_PAGE_3))
+    {
+      continue;
+    }
+    u32int pageAddress = (virtAddr & SECTION_MASK) | (index << 12);
+    smallPageEntry* shadowSmallPage = (smallPageEntry *)getEntrySecond(context, shadowFirst, pageAddress);
+    if (((simpleEntry *)shadowSmallPage)->type != FAULT
+        || !isFaultAroundCandidate(context, ((smallPageEntry *)guestSecond)->addr << 12))
+    {
+      continue;
+    }
+    DEBUG(MM_SHADOWING, "shadowMapAround: VA %#.8x guest 2nd lvl entry %#.8x" EOL, pageAddress,
+          *(u32int *)guestSecond);
+    shadowMapSmallPage(context, (smallPageEntry *)guestSecond, shadowSmallPage, guestFirst->domain);
+    mmuPageTableEdit((u32int)shadowSmallPage, pageAddress);
+    countFaultAroundPage(&context->counters);
+  }
+}
+
+
+/**
+ * only guest RAM that holds no guest page tables is mapped ahead of a fault. pages that must be
+ * write-protected, device pages and the hypervisor are left to fault on their own.
+ **/
+static bool isFaultAroundCandidate(GCONTXT *context, u32int guestPhysical)
+{
+  if ((guestPhysical < MEMORY_START_ADDR) || (guestPhysical >= HYPERVISOR_BEGIN_ADDRESS))
+  {
+    return FALSE;
+  }
+
+  u32int gpt1PhysAddr = (u32int)context->pageTables->guestPhysical & PT1_ALIGN_MASK;
+  if ((guestPhysical >= gpt1PhysAddr) && (guestPhysical < gpt1PhysAddr + PT1_SIZE))
+  {
+    return FALSE;
+  }
+
+  ptInfo* head;
+  for (head = context->pageTables->gptInfo; head != NULL; head = head->nextEntry)
+  {
+    if ((head->physAddr & SMALL_PAGE_MASK) == guestPhysical)
+    {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+#endif
+
+
 /**
  * takes pointers to guest and shadow page table section entries
  * maps/copies data from guest to shadow entry
@@ -224,7 +328,8 @@ void shadowMapSection(GCONTXT *context, sectionEntry* guest, sectionEntry* shado
   shadow->b = 0;
   shadow->s = 0;
   shadow->tex = peripheral ? 0b000 : 0b100;
-  shadow->nG = guest->nG;
+  // the shadow page tables map guest global pages differently, see addressing.c
+  shadow->nG = 1;
   shadow->ns = 0;
   shadow->domain = guest->domain;
   DEBUG(MM_SHADOWING, "shadowMapSection: Shadow entry now @ %p = %#.8x" EOL, shadow,
@@ -266,9 +371,59 @@ void shadowMapSection(GCONTXT *context, sectionEntry* guest, sectionEntry* shado
   }
   DEBUG(MM_SHADOWING, "shadowMapSection: Shadow entry after AP map @ %p = %#.x" EOL, shadow,
         *(u32int *)shadow);
+
+#ifndef CONFIG_HW_PASSTHROUGH
+  if (peripheral)
+  {
+    mapDirectReadPages(context, guest, shadow, virtual);
+  }
+#endif
 }
 
 
+#ifndef CONFIG_HW_PASSTHROUGH
+/**
+ * all guest accesses to a peripheral section trap. if the section holds device registers that
+ * the guest may read directly (see isDirectReadAddress()), split the shadow section to small pages
+ * and make those pages read-only for the guest; writes still trap.
+ **/
+static void mapDirectReadPages(GCONTXT *context, sectionEntry* guest, sectionEntry* shadow, u32int virtual)
+{
+  u32int guestAP = (guest->ap2 << 2) | guest->ap10;
+  u32int shadowAP = mapAccessPermissionBits(context, guestAP, guest->domain);
+  if ((shadowAP != PRIV_RW_USR_RO) && (shadowAP != PRIV_RW_USR_RW))
+  {
+    // the guest can't read this section in its current mode anyway
+    return;
+  }
+
+  simpleEntry* shadowTable = (simpleEntry *)((u32int)shadow & PT1_ALIGN_MASK);
+  u32int guestPhysAddr = guest->addr << 20;
+  u32int index;
+  for (index = 0; index < PT2_ENTRIES; index++)
+  {
+    if (!isDirectReadAddress(context, guestPhysAddr + index * SMALL_PAGE_SIZE))
+    {
+      continue;
+    }
+    if (shadow->type == SECTION)
+    {
+      DEBUG(MM_SHADOWING, "mapDirectReadPages: split peripheral section @ VA %#.8x" EOL, virtual);
+      splitSectionToSmallPages(shadowTable, virtual);
+    }
+
+    u32int pageAddress = virtual + index * SMALL_PAGE_SIZE;
+    smallPageEntry* page =
+      (smallPageEntry *)getEntrySecond(context, (pageTableEntry *)shadow, pageAddress);
+    page->ap2  = PRIV_RW_USR_RO >> 2;
+    page->ap10 = PRIV_RW_USR_RO & 0x3;
+    mmuPageTableEdit((u32int)page, pageAddress);
+    DEBUG(MM_SHADOWING, "mapDirectReadPages: VA %#.8x read-only for guest" EOL, pageAddress);
+  }
+}
+#endif
+
+
 /**
  * takes pointers to guest and shadow page table section entries
  * removes the shadow mapping for the corresponding guest entry
@@ -325,7 +480,8 @@ void shadowUnmapSection(GCONTXT *context, simpleEntry* shadow, sectionEntry* gue
 
   // and finally, remove the shadow entry!
   *(u32int *)shadow = 0;
-  mmuInvalidateUTLBbyMVA(virtual);
+  invalidateShadowTLBbyMVA(context, virtual);
+  invalidateSoftwareTLBRange(context, virtual, virtual + SECTION_SIZE - 1);
   mmuDataMemoryBarrier();
 }
 
@@ -396,133 +552,87 @@ void shadowMapPageTable(GCONTXT *context, pageTableEntry* guest, pageTableEntry*
   // ok. we must scan the shadow PT looking for previously shadow mapped entries
   // that point to this new guest 2nd lvl page table. if found, write-protect
   u32int gptPhysical = guest->addr << 10;
-  simpleEntry* shadowActiveBackup = context->pageTables->shadowActive;
-  simpleEntry* shadowUser = context->pageTables->shadowUser;
-  simpleEntry* shadowPriv = context->pageTables->shadowPriv;
+  writeProtectGuestPageTable(context, gptPhysical, PT2_SIZE);
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  writeProtectCachedPageTable(context, gptPhysical, PT2_SIZE);
+#endif
+}
 
-  u32int i = 0;
-  for (i=0; i < PT1_ENTRIES; i++)
+
+/**
+ * scans both shadow page tables for entries that map the guest page table at this guest
+ * physical address, and write-protects them
+ **/
+static void writeProtectGuestPageTable(GCONTXT *context, u32int gptPhysical, u32int size)
+{
+  u32int table;
+  for (table = 0; table < 2; table++)
   {
-    context->pageTables->shadowActive = shadowUser;
-    if (shadowUser[i].type == SECTION && shadowUser[i].domain != HYPERVISOR_ACCESS_DOMAIN)
+    simpleEntry* shadowFirst = table ? context->pageTables->shadowPriv
+                                     : context->pageTables->shadowUser;
+    u32int i;
+    for (i = 0; i < PT1_ENTRIES; i++)
     {
-      sectionEntry* sectionPtr = (sectionEntry*)&shadowUser[i];
-      u32int section = sectionPtr->addr << 20;
-      if ((section <= gptPhysical) && ((section + SECTION_SIZE - 1) >= gptPhysical))
+      if (shadowFirst[i].domain == HYPERVISOR_ACCESS_DOMAIN)
       {
-        DEBUG(MM_SHADOWING, "shadowMapPageTable: section %#.8x maps guest PT2 %#.8x" EOL, section,
-              gptPhysical);
-        // guest protect PT2
-        u32int virtualAddress = i << 20;
-        virtualAddress |= (gptPhysical & ~SECTION_MASK);
-        DEBUG(MM_SHADOWING, "shadowMapPageTable: virtualAddress of gPT2 %#.8x" EOL, virtualAddress);
-        guestWriteProtect(context, virtualAddress, virtualAddress + PT2_SIZE - 1);
+        continue;
       }
-    }
-    else if (shadowUser[i].type == PAGE_TABLE && shadowUser[i].domain != HYPERVISOR_ACCESS_DOMAIN)
-    {
-      pageTableEntry* pageTablePtr = (pageTableEntry*)&shadowUser[i];
-      ptInfo* metadata = getPageTableInfo(context, pageTablePtr);
-      if (metadata == 0)
+      if (shadowFirst[i].type == SECTION)
       {
-        DIE_NOW(context, "sPT2 metadata not found while checking AP");
+        sectionEntry* sectionPtr = (sectionEntry*)&shadowFirst[i];
+        u32int section = sectionPtr->addr << 20;
+        if ((section <= gptPhysical) && ((section + SECTION_SIZE - 1) >= gptPhysical))
+        {
+          DEBUG(MM_SHADOWING, "writeProtectGuestPageTable: section %#.8x maps guest PT %#.8x" EOL,
+                section, gptPhysical);
+          // guest protect PT
+          u32int virtualAddress = i << 20;
+          virtualAddress |= (gptPhysical & ~SECTION_MASK);
+          DEBUG(MM_SHADOWING, "writeProtectGuestPageTable: virtualAddress of gPT %#.8x" EOL,
+                virtualAddress);
+          guestWriteProtect(context, virtualAddress, virtualAddress + size - 1);
+        }
       }
-      simpleEntry* tempPageTable = (simpleEntry*)(metadata->virtAddr);
-      u32int y = 0;
-      for (y = 0; y < PT2_ENTRIES; y++)
+      else if (shadowFirst[i].type == PAGE_TABLE)
       {
-        if (tempPageTable[y].type != FAULT)
+        pageTableEntry* pageTablePtr = (pageTableEntry*)&shadowFirst[i];
+        ptInfo* metadata = getPageTableInfo(context, pageTablePtr);
+        if (metadata == 0)
+        {
+          DIE_NOW(context, "writeProtectGuestPageTable: sPT2 metadata not found while checking AP");
+        }
+        simpleEntry* tempPageTable = (simpleEntry*)(metadata->virtAddr);
+        u32int y = 0;
+        for (y = 0; y < PT2_ENTRIES; y++)
         {
-          if (tempPageTable[y].type == LARGE_PAGE)
+          bool mapsTable;
+          if (tempPageTable[y].type == FAULT)
           {
-            largePageEntry* largePage = (largePageEntry*)&tempPageTable[y]; 
-            u32int phys = largePage->addr << 16;
-            u32int physPageTableMasked = gptPhysical & LARGE_PAGE_MASK;
-            if (phys == physPageTableMasked)
-            {
-              u32int virtualAddress = i << 20;
-              virtualAddress |= (y << 12);
-              guestWriteProtect(context, virtualAddress, virtualAddress + PT2_SIZE - 1);
-            }
+            continue;
           }
-          else
+          else if (tempPageTable[y].type == LARGE_PAGE)
           {
-            // must calculate what VA guest is trying to map with this small page
-            smallPageEntry* smallPage = (smallPageEntry*)&tempPageTable[y]; 
-            u32int phys = smallPage->addr << 12;
-            u32int physPageTableMasked = gptPhysical & SMALL_PAGE_MASK;
-            if (phys == physPageTableMasked)
-            {
-              u32int virtualAddress = i << 20;
-              virtualAddress |= (y << 12);
-              guestWriteProtect(context, virtualAddress, virtualAddress + PT2_SIZE - 1);
-            }
-          }
-        } // !fault
-      } // for loop
-    } // host PAGE_TABLE
-
-    context->pageTables->shadowActive = shadowPriv;
-    if ((shadowPriv[i].type == SECTION) && (shadowUser[i].domain != HYPERVISOR_ACCESS_DOMAIN))
-    {
-      sectionEntry *sectionPtr = (sectionEntry *)&shadowPriv[i];
-      u32int section = sectionPtr->addr << 20;
-      if ((section <= gptPhysical) && ((section + SECTION_SIZE - 1) >= gptPhysical))
-      {
-        DEBUG(MM_SHADOWING, "shadowMapPageTable: section %#.8x maps guest PT2 %#.8x" EOL, section,
-              gptPhysical);
-        // guest protect PT2
-        u32int virtualAddress = i << 20;
-        virtualAddress |= (gptPhysical & ~SECTION_MASK);
-        DEBUG(MM_SHADOWING, "shadowMapPageTable: virtualAddress of gPT2 %#.8x" EOL, virtualAddress);
-        guestWriteProtect(context, virtualAddress, virtualAddress + PT2_SIZE - 1);
-      }
-    }
-    else if ((shadowPriv[i].type == PAGE_TABLE) && (shadowUser[i].domain != HYPERVISOR_ACCESS_DOMAIN))
-    {
-      pageTableEntry* pageTablePtr = (pageTableEntry*)&shadowPriv[i];
-      ptInfo* metadata = getPageTableInfo(context, pageTablePtr);
-      if (metadata == 0)
-      {
-        DIE_NOW(context, "shadowMapPageTable: sPT2 metadata not found while checking AP");
-      }
-      simpleEntry* tempPageTable = (simpleEntry*)(metadata->virtAddr);
-      u32int y = 0;
-
-      for (y = 0; y < PT2_ENTRIES; y++)
-      {
-        if (tempPageTable[y].type != FAULT)
-        {
-          if(tempPageTable[y].type == LARGE_PAGE)
-          {
-            largePageEntry* largePage = (largePageEntry*)&tempPageTable[y]; 
+            largePageEntry* largePage = (largePageEntry*)&tempPageTable[y];
             u32int phys = largePage->addr << 16;
-            u32int physPageTableMasked = gptPhysical & LARGE_PAGE_MASK;
-            if (phys == physPageTableMasked)
-            {
-              u32int virtualAddress = i << 20;
-              virtualAddress |= (y << 12);
-              guestWriteProtect(context, virtualAddress, virtualAddress + PT2_SIZE - 1);
-            }
+            mapsTable = (phys == (gptPhysical & LARGE_PAGE_MASK));
           }
           else
           {
             // must calculate what VA guest is trying to map with this small page
-            smallPageEntry *smallPage = (smallPageEntry *)&tempPageTable[y];
+            smallPageEntry* smallPage = (smallPageEntry*)&tempPageTable[y];
             u32int phys = smallPage->addr << 12;
-            u32int physPageTableMasked = gptPhysical & SMALL_PAGE_MASK;
-            if (phys == physPageTableMasked)
-            {
-              u32int virtualAddress = i << 20;
-              virtualAddress |= (y << 12);
-              guestWriteProtect(context, virtualAddress, virtualAddress + PT2_SIZE - 1);
-            }
+            mapsTable = (phys >= (gptPhysical & SMALL_PAGE_MASK)) && (phys < gptPhysical + size);
           }
-        } // !fault
-      } // for loop
-    } // host PAGE_TABLE
-  } // for loop
-  context->pageTables->shadowActive = shadowActiveBackup;
+          if (mapsTable)
+          {
+            u32int virtualAddress = i << 20;
+            virtualAddress |= (y << 12);
+            guestWriteProtect(context, virtualAddress, virtualAddress + PT2_SIZE - 1);
+          }
+        } // for loop
+      } // host PAGE_TABLE
+    } // for loop
+  }
 }
 
 
@@ -590,7 +700,8 @@ void shadowUnmapPageTable(GCONTXT *context, pageTableEntry *shadow, pageTableEnt
 
   // and finally, remove the shadow entry!
   *(u32int *)shadow = 0;
-  mmuInvalidateUTLBbyMVA(virtual);
+  invalidateShadowTLBbyMVA(context, virtual);
+  invalidateSoftwareTLBRange(context, virtual, virtual + SECTION_SIZE - 1);
   mmuDataMemoryBarrier();
 }
 
@@ -689,7 +800,8 @@ void shadowMapSmallPage(GCONTXT *context, smallPageEntry* guest, smallPageEntry*
   shadow->b = 0;
   shadow->tex = 0b100;
   shadow->s = 0;
-  shadow->nG = guest->nG;
+  // the shadow page tables map guest global pages differently, see addressing.c
+  shadow->nG = 1;
 
   DEBUG(MM_SHADOWING, "shadowMapSmallPage: Shadow at the end @ %p = %#.8x" EOL, shadow,
         *(u32int *)shadow);
@@ -744,7 +856,7 @@ void shadowUnmapSmallPage(GCONTXT *context, smallPageEntry* shadow, smallPageEnt
   
   // and finally, remove the shadow entry!
   *(u32int *)shadow = 0;
-  mmuInvalidateUTLBbyMVA(virtual);
+  invalidateShadowTLBbyMVA(context, virtual);
   mmuDataMemoryBarrier();
 }
 
@@ -913,6 +1025,11 @@ void mapAPBitsSection(GCONTXT *context, sectionEntry* guest, simpleEntry* shadow
     }
     head = head->nextEntry;
   } // while ends
+
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  // and so may the page tables of the other cached address spaces
+  writeProtectCachedTablesInSection(context, guestPhysical, virtual);
+#endif
 }
 
 
@@ -970,11 +1087,12 @@ void mapAPBitsPageTable(GCONTXT* context, pageTableEntry* guest, pageTableEntry*
         mapAPBitsSmallPage(context, guest->domain, guestSmallPage, shadowSmallPage);
         u32int pageAddress = metadata->mappedMegabyte + i * SMALL_PAGE_SIZE;
         mmuPageTableEdit((u32int)shadowSmallPage, pageAddress);
+        invalidateShadowTLBbyMVA(context, pageAddress);
       }
     } // switch ends
   } // for ends
 
-  mmuSetTTBR0(ttbrBackup, 0x100 | context->pageTables->contextID);
+  mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
 }
 
 
@@ -1025,4 +1143,534 @@ void mapAPBitsSmallPage(GCONTXT *context, u32int dom, smallPageEntry* guest, sma
     head = head->nextEntry;
   }
   while (head != NULL);
+
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  // page tables of the other cached address spaces stay write-protected, as in writeProtectRange()
+  if ((shadowAP == PRIV_RW_USR_RW) && isCachedPageTable(context, guestPhysical, SMALL_PAGE_SIZE))
+  {
+    shadow->ap10 = PRIV_RW_USR_RO & 0x3;
+    shadow->ap2 = PRIV_RW_USR_RO >> 2;
+  }
+#endif
+}
+
+
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+/**
+ * returns whether [physical, physical + size) overlaps a guest page table of this address space
+ **/
+static bool isInPageTables(pageTablesVM* pageTables, u32int physical, u32int size)
+{
+  u32int guestFirst = (u32int)pageTables->guestPhysical & PT1_ALIGN_MASK;
+  if ((physical < guestFirst + PT1_SIZE) && (physical + size > guestFirst))
+  {
+    return TRUE;
+  }
+
+  ptInfo* head;
+  for (head = pageTables->gptInfo; head != NULL; head = head->nextEntry)
+  {
+    if ((physical < head->physAddr + PT2_SIZE) && (physical + size > head->physAddr))
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+
+/**
+ * returns whether [physical, physical + size) overlaps a guest page table of a cached address
+ * space other than the active one
+ **/
+static bool isCachedPageTable(GCONTXT *context, u32int physical, u32int size)
+{
+  u32int i;
+  for (i = 0; i < SHADOW_PAGE_TABLE_CACHE_SIZE; i++)
+  {
+    pageTablesVM* entry = &context->pageTableCache[i];
+    if (entry != context->pageTables && entry->guestPhysical != NULL
+        && isInPageTables(entry, physical, size))
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+
+/**
+ * write-protects the page tables of the other cached address spaces that live in the guest
+ * physical section mapped at this virtual address by the active shadow page tables
+ **/
+static void writeProtectCachedTablesInSection(GCONTXT *context, u32int guestPhysical,
+                                              u32int virtual)
+{
+  u32int i;
+  for (i = 0; i < SHADOW_PAGE_TABLE_CACHE_SIZE; i++)
+  {
+    pageTablesVM* entry = &context->pageTableCache[i];
+    if (entry == context->pageTables || entry->guestPhysical == NULL)
+    {
+      continue;
+    }
+
+    u32int guestFirst = (u32int)entry->guestPhysical & PT1_ALIGN_MASK;
+    if ((guestFirst & SECTION_MASK) == guestPhysical)
+    {
+      u32int virtualAddress = virtual | (guestFirst & ~SECTION_MASK);
+      guestWriteProtect(context, virtualAddress, virtualAddress + PT1_SIZE - 1);
+    }
+
+    ptInfo* head;
+    for (head = entry->gptInfo; head != NULL; head = head->nextEntry)
+    {
+      if ((head->physAddr & SECTION_MASK) == guestPhysical)
+      {
+        u32int virtualAddress = virtual | (head->physAddr & ~SECTION_MASK);
+        guestWriteProtect(context, virtualAddress, virtualAddress + PT2_SIZE - 1);
+      }
+    }
+  }
+}
+
+
+/**
+ * write-protects a new guest page table of the active address space in the shadow page tables of
+ * the other cached address spaces, so that the guest cannot change it through them unseen.
+ **/
+void writeProtectCachedPageTable(GCONTXT *context, u32int physical, u32int size)
+{
+  pageTablesVM* active = context->pageTables;
+  u32int i;
+  for (i = 0; i < SHADOW_PAGE_TABLE_CACHE_SIZE; i++)
+  {
+    pageTablesVM* entry = &context->pageTableCache[i];
+    if (entry == active || entry->guestPhysical == NULL)
+    {
+      continue;
+    }
+    context->pageTables = entry;
+    writeProtectGuestPageTable(context, physical, size);
+  }
+  context->pageTables = active;
+}
+
+
+/**
+ * called for every word the guest stores to a write-protected page of RAM. the page tables of
+ * all cached address spaces are write-protected in the active shadow page tables; a write to
+ * those of a switched out address space is logged, and syncShadowPageTables() catches up with it
+ * on switching back.
+ **/
+void trackCachedPageTableWrite(GCONTXT *context, u32int physical, u32int oldValue, u32int newValue)
+{
+  if (oldValue == newValue)
+  {
+    return;
+  }
+
+  u32int i;
+  for (i = 0; i < SHADOW_PAGE_TABLE_CACHE_SIZE; i++)
+  {
+    pageTablesVM* entry = &context->pageTableCache[i];
+    if (entry == context->pageTables || entry->guestPhysical == NULL
+        || !isInPageTables(entry, physical, sizeof(u32int)))
+    {
+      continue;
+    }
+
+    DEBUG(MM_SHADOWING, "trackCachedPageTableWrite: gPT %p PA %#.8x was %#.8x now %#.8x" EOL,
+          entry->guestPhysical, physical, oldValue, newValue);
+    u32int count = entry->writeLogCount;
+    if (count < SHADOW_PAGE_TABLE_WRITE_LOG_SIZE)
+    {
+      entry->writeLog[count].physical = physical;
+      entry->writeLog[count].oldValue = oldValue;
+      entry->writeLogCount = count + 1;
+    }
+    else
+    {
+      // log overflow, the shadow page tables are rebuilt on switching back
+      entry->writeLogCount = SHADOW_PAGE_TABLE_WRITE_LOG_SIZE + 1;
+    }
+  }
 }
+
+
+/**
+ * called when switching back to an address space with cached shadow page tables. the guest page
+ * table entries written while it was switched out are unmapped from the shadow page tables, and
+ * will be shadow mapped again on the next access. returns FALSE if more writes were trapped than
+ * the log holds; the shadow page tables must then be rebuilt.
+ **/
+bool syncShadowPageTables(GCONTXT *context)
+{
+  pageTablesVM* pageTables = context->pageTables;
+  u32int count = pageTables->writeLogCount;
+  DEBUG(MM_SHADOWING, "syncShadowPageTables: gPT %p, %#x writes" EOL, pageTables->guestPhysical,
+        count);
+
+  pageTables->writeLogCount = 0;
+  if (count > SHADOW_PAGE_TABLE_WRITE_LOG_SIZE)
+  {
+    return FALSE;
+  }
+  if (count == 0)
+  {
+    return TRUE;
+  }
+
+  simpleEntry* ttbrBackup = mmuGetTTBR0();
+  mmuSetTTBR0(context->hypervisorPageTable, HYPERVISOR_CONTEXT_ID);
+
+  u32int guestFirst = (u32int)pageTables->guestPhysical & PT1_ALIGN_MASK;
+  u32int i;
+  for (i = 0; i < count; i++)
+  {
+    u32int physical = pageTables->writeLog[i].physical;
+    simpleEntry* oldEntry = (simpleEntry *)&pageTables->writeLog[i].oldValue;
+
+    if ((physical >= guestFirst) && (physical < guestFirst + PT1_SIZE))
+    {
+      u32int virtual = ((physical - guestFirst) >> 2) << 20;
+      DEBUG(MM_SHADOWING, "syncShadowPageTables: VA %#.8x was %#.8x" EOL, virtual,
+            *(u32int *)oldEntry);
+      switch (oldEntry->type)
+      {
+        case SECTION:
+        {
+          shadowUnmapSection(context, getEntryFirst(pageTables->shadowPriv, virtual),
+                             (sectionEntry *)oldEntry, virtual);
+          shadowUnmapSection(context, getEntryFirst(pageTables->shadowUser, virtual),
+                             (sectionEntry *)oldEntry, virtual);
+          break;
+        }
+        case PAGE_TABLE:
+        {
+          removePageTableInfo(context, (pageTableEntry *)physical, FALSE);
+          simpleEntry* shadowFirst = getEntryFirst(pageTables->shadowPriv, virtual);
+          shadowUnmapPageTable(context, (pageTableEntry *)shadowFirst, (pageTableEntry *)oldEntry,
+                               virtual);
+          shadowFirst = getEntryFirst(pageTables->shadowUser, virtual);
+          shadowUnmapPageTable(context, (pageTableEntry *)shadowFirst, (pageTableEntry *)oldEntry,
+                               virtual);
+          break;
+        }
+        default:
+        {
+          // nothing can be shadow mapped for a fault entry
+          break;
+        }
+      }
+      continue;
+    }
+
+    ptInfo* head = pageTables->gptInfo;
+    while ((head != NULL) && (head->physAddr != (physical & PT2_ALIGN_MASK)))
+    {
+      head = head->nextEntry;
+    }
+    if (head == NULL)
+    {
+      // not shadow mapped, or unmapped along with its 1st lvl entry above
+      continue;
+    }
+    u32int virtual = head->mappedMegabyte | ((physical & ~PT2_ALIGN_MASK) << 10);
+    DEBUG(MM_SHADOWING, "syncShadowPageTables: VA %#.8x was %#.8x" EOL, virtual,
+          *(u32int *)oldEntry);
+    switch (oldEntry->type)
+    {
+      case SMALL_PAGE:
+      case SMALL_PAGE_3:
+      {
+        syncUnmapSmallPage(context, pageTables->shadowPriv, (smallPageEntry *)oldEntry, virtual);
+        syncUnmapSmallPage(context, pageTables->shadowUser, (smallPageEntry *)oldEntry, virtual);
+        break;
+      }
+      case LARGE_PAGE:
+      {
+        DIE_NOW(context, ERROR_NOT_IMPLEMENTED);
+      }
+      default:
+      {
+        break;
+      }
+    }
+  }
+
+  mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
+  return TRUE;
+}
+#endif /* CONFIG_SHADOW_PAGE_TABLE_CACHE */
+
+
+#if defined(CONFIG_SHADOW_PAGE_TABLE_CACHE) || CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+static void syncUnmapSmallPage(GCONTXT *context, simpleEntry* shadowTable, smallPageEntry* guest,
+                               u32int virtual)
+{
+  simpleEntry* shadow = getEntryFirst(shadowTable, virtual);
+  if (shadow->type == PAGE_TABLE)
+  {
+    shadow = getEntrySecond(context, (pageTableEntry *)shadow, virtual);
+    shadowUnmapSmallPage(context, (smallPageEntry *)shadow, guest, virtual);
+  }
+}
+#endif
+
+
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+/**
+ * unmaps every entry of a guest 2nd lvl page table that differs from its copy from the shadow
+ * page tables, and brings the copy up to date. the hypervisor page table must be active.
+ * returns whether any entry differed.
+ **/
+static bool syncPageTable(GCONTXT *context, ptInfo* metadata, u32int virtual)
+{
+  pageTablesVM* pageTables = context->pageTables;
+  u32int* guestSecond = (u32int *)metadata->physAddr;
+  bool changed = FALSE;
+  u32int i;
+  for (i = 0; i < PT2_ENTRIES; i++)
+  {
+    if (guestSecond[i] == metadata->snapshot[i])
+    {
+      continue;
+    }
+    changed = TRUE;
+
+    simpleEntry* oldEntry = (simpleEntry *)&metadata->snapshot[i];
+    u32int pageVirtual = virtual | (i << 12);
+    DEBUG(MM_SHADOWING, "syncPageTable: VA %#.8x was %#.8x now %#.8x" EOL, pageVirtual,
+          metadata->snapshot[i], guestSecond[i]);
+    switch (oldEntry->type)
+    {
+      case SMALL_PAGE:
+      case SMALL_PAGE_3:
+      {
+        syncUnmapSmallPage(context, pageTables->shadowPriv, (smallPageEntry *)oldEntry, pageVirtual);
+        syncUnmapSmallPage(context, pageTables->shadowUser, (smallPageEntry *)oldEntry, pageVirtual);
+        break;
+      }
+      case LARGE_PAGE:
+      {
+        DIE_NOW(context, ERROR_NOT_IMPLEMENTED);
+      }
+      default:
+      {
+        break;
+      }
+    }
+    metadata->snapshot[i] = guestSecond[i];
+  }
+  return changed;
+}
+
+
+/**
+ * called by pageTableEdit() for every trapped write to a guest 2nd lvl page table.
+ * guests rewrite their page tables in bursts, e.g. on fork, exec and exit. once a page table has
+ * taken CONFIG_SHADOW_UNSYNC_THRESHOLD trapped writes, the page holding it is made writable
+ * through the active shadow page table, see unsyncPageTables(). the count starts over once a
+ * resync finds the table unchanged and write-protects the page again.
+ **/
+void trackPageTableWrite(GCONTXT *context, ptInfo* metadata, u32int virtual, u32int newValue)
+{
+  if (!metadata->outOfSync && ++metadata->writeCount < CONFIG_SHADOW_UNSYNC_THRESHOLD)
+  {
+    return;
+  }
+
+  // a page table that is already out of sync was written through a mapping still write-protected
+  unsyncPageTables(context, metadata->physAddr & SMALL_PAGE_MASK, virtual);
+
+  if (metadata->outOfSync)
+  {
+    // pageTableEdit() updates the shadow entries before the write reaches guest memory
+    metadata->snapshot[(virtual & ~PT2_ALIGN_MASK) >> 2] = newValue;
+  }
+}
+
+
+/**
+ * takes a copy of every guest 2nd lvl page table in the guest physical page, marks them out of
+ * sync and stops write-protecting the page at this virtual address in the active shadow page
+ * table. the shadow page tables keep the entries of the copy until resyncPageTables().
+ **/
+static void unsyncPageTables(GCONTXT *context, u32int physical, u32int virtual)
+{
+  pageTablesVM* pageTables = context->pageTables;
+
+  // the guest 1st lvl page table must stay write-protected
+  u32int guestFirst = (u32int)pageTables->guestPhysical & PT1_ALIGN_MASK;
+  if ((physical < guestFirst + PT1_SIZE) && (physical + SMALL_PAGE_SIZE > guestFirst))
+  {
+    return;
+  }
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+  // and so must the page tables of the other cached address spaces
+  if (isCachedPageTable(context, physical, SMALL_PAGE_SIZE))
+  {
+    return;
+  }
+#endif
+
+  simpleEntry* shadowFirst = getEntryFirst(pageTables->shadowActive, virtual);
+  if (shadowFirst->type != PAGE_TABLE)
+  {
+    return;
+  }
+  smallPageEntry* shadow = (smallPageEntry *)getEntrySecond(context, (pageTableEntry *)shadowFirst,
+                                                            virtual);
+  if (((shadow->type != SMALL_PAGE) && (shadow->type != SMALL_PAGE_3))
+      || ((shadow->ap10 | (shadow->ap2 << 2)) != PRIV_RW_USR_RO))
+  {
+    // not write-protected by writeProtectRange()
+    return;
+  }
+
+  simpleEntry* ttbrBackup = mmuGetTTBR0();
+  mmuSetTTBR0(context->hypervisorPageTable, HYPERVISOR_CONTEXT_ID);
+
+  ptInfo* head;
+  for (head = pageTables->gptInfo; head != NULL; head = head->nextEntry)
+  {
+    if (head->outOfSync || ((head->physAddr & SMALL_PAGE_MASK) != physical))
+    {
+      continue;
+    }
+    if (head->snapshot == NULL)
+    {
+      head->snapshot = (u32int *)malloc(PT2_SIZE);
+      if (head->snapshot == NULL)
+      {
+        DIE_NOW(context, "unsyncPageTables: failed to allocate copy of gPT2");
+      }
+    }
+    memcpy(head->snapshot, (void *)head->physAddr, PT2_SIZE);
+    head->outOfSync = TRUE;
+    // nonzero while out of sync until a resync finds the table unchanged, see resyncPageTables()
+    head->writeCount = CONFIG_SHADOW_UNSYNC_THRESHOLD;
+    head->unsyncedVirtual = virtual & SMALL_PAGE_MASK;
+    head->nextUnsynced = pageTables->unsyncedInfo;
+    pageTables->unsyncedInfo = head;
+    countUnsyncedPageTable(&context->counters);
+  }
+
+  mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
+
+  DEBUG(MM_SHADOWING, "unsyncPageTables: PA %#.8x VA %#.8x" EOL, physical, virtual);
+  shadow->ap10 = PRIV_RW_USR_RW & 0x3;
+  shadow->ap2 = PRIV_RW_USR_RW >> 2;
+  invalidateTLBbyMVA(context, pageTables->shadowActive, virtual);
+}
+
+
+/**
+ * brings the shadow entries of the out of sync guest 2nd lvl page tables mapping any address in
+ * [startAddress, endAddress] up to date. called when the guest invalidates its TLB or switches
+ * TTBR0 or the context ID; only then must its page table changes take effect.
+ *
+ * the writeCount of a resynced table is reset to whether it changed since the last resync. the
+ * pages in which no out of sync table changed are write-protected again, and their tables go back
+ * in sync: they must take CONFIG_SHADOW_UNSYNC_THRESHOLD trapped writes to go out of sync again,
+ * and later resyncs do not have to diff them.
+ **/
+void resyncPageTables(GCONTXT *context, u32int startAddress, u32int endAddress)
+{
+  pageTablesVM* pageTables = context->pageTables;
+  if (pageTables->unsyncedInfo == NULL)
+  {
+    return;
+  }
+  DEBUG(MM_SHADOWING, "resyncPageTables: %#.8x - %#.8x" EOL, startAddress, endAddress);
+
+  simpleEntry* ttbrBackup = mmuGetTTBR0();
+  mmuSetTTBR0(context->hypervisorPageTable, HYPERVISOR_CONTEXT_ID);
+
+  ptInfo* head;
+  for (head = pageTables->unsyncedInfo; head != NULL; head = head->nextUnsynced)
+  {
+    if ((head->mappedMegabyte > endAddress)
+        || (head->mappedMegabyte + (SECTION_SIZE - 1) < startAddress))
+    {
+      continue;
+    }
+    head->writeCount = syncPageTable(context, head, head->mappedMegabyte) ? 1 : 0;
+    countResyncedPageTable(&context->counters);
+  }
+
+  head = pageTables->unsyncedInfo;
+  while (head != NULL)
+  {
+    u32int physical = head->physAddr & SMALL_PAGE_MASK;
+    if (head->writeCount == 0 && isQuietPageTablePage(context, physical, startAddress, endAddress))
+    {
+      reprotectPageTables(context, physical, head->unsyncedVirtual);
+      // the list changed, and may have lost the next entry as well
+      head = pageTables->unsyncedInfo;
+      continue;
+    }
+    head = head->nextUnsynced;
+  }
+
+  mmuSetTTBR0(ttbrBackup, getHostContextID(context, ttbrBackup));
+}
+
+
+/**
+ * checks whether none of the out of sync guest 2nd lvl page tables in the guest physical page
+ * changed since the last resync. tables outside [startAddress, endAddress] were not diffed by the
+ * current resync, so they are diffed here. the hypervisor page table must be active.
+ **/
+static bool isQuietPageTablePage(GCONTXT *context, u32int physical, u32int startAddress,
+                                 u32int endAddress)
+{
+  bool quiet = TRUE;
+  ptInfo* head;
+  for (head = context->pageTables->unsyncedInfo; head != NULL; head = head->nextUnsynced)
+  {
+    if ((head->physAddr & SMALL_PAGE_MASK) != physical)
+    {
+      continue;
+    }
+    if ((head->mappedMegabyte > endAddress)
+        || (head->mappedMegabyte + (SECTION_SIZE - 1) < startAddress))
+    {
+      head->writeCount = syncPageTable(context, head, head->mappedMegabyte) ? 1 : 0;
+    }
+    quiet = quiet && (head->writeCount == 0);
+  }
+  return quiet;
+}
+
+
+/**
+ * write-protects the guest physical page at the virtual address unsyncPageTables() made writable,
+ * and takes every guest 2nd lvl page table in it back in sync.
+ **/
+static void reprotectPageTables(GCONTXT *context, u32int physical, u32int virtual)
+{
+  pageTablesVM* pageTables = context->pageTables;
+  DEBUG(MM_SHADOWING, "reprotectPageTables: PA %#.8x VA %#.8x" EOL, physical, virtual);
+
+  writeProtectRange(context, pageTables->shadowPriv, virtual, virtual + SMALL_PAGE_SIZE - 1);
+  writeProtectRange(context, pageTables->shadowUser, virtual, virtual + SMALL_PAGE_SIZE - 1);
+
+  ptInfo** link = &pageTables->unsyncedInfo;
+  while (*link != NULL)
+  {
+    ptInfo* head = *link;
+    if ((head->physAddr & SMALL_PAGE_MASK) != physical)
+    {
+      link = &head->nextUnsynced;
+      continue;
+    }
+    *link = head->nextUnsynced;
+    head->outOfSync = FALSE;
+    head->writeCount = 0;
+    countReprotectedPageTable(&context->counters);
+  }
+}
+#endif
+
@@ -4,6 +4,7 @@
 #include "common/types.h"
 
 #include "memoryManager/pageTable.h"
+#include "memoryManager/pageTableInfo.h"
 
 
 bool shadowMap(GCONTXT *context, u32int virtAddr);
@@ -22,4 +23,18 @@ void mapAPBitsSection(GCONTXT *context, sectionEntry* guest, simpleEntry* shadow
 void mapAPBitsPageTable(GCONTXT *context, pageTableEntry* guest, pageTableEntry* shadow);
 void mapAPBitsSmallPage(GCONTXT *context, u32int dom, smallPageEntry* guest, smallPageEntry* shadow);
 
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+void writeProtectCachedPageTable(GCONTXT *context, u32int physical, u32int size);
+void trackCachedPageTableWrite(GCONTXT *context, u32int physical, u32int oldValue, u32int newValue);
+bool syncShadowPageTables(GCONTXT *context);
+#endif
+
+#if CONFIG_SHADOW_UNSYNC_THRESHOLD > 0
+void trackPageTableWrite(GCONTXT *context, ptInfo* metadata, u32int virtual, u32int newValue);
+void resyncPageTables(GCONTXT *context, u32int startAddress, u32int endAddress);
+#else
+#define trackPageTableWrite(context, metadata, virtual, newValue)
+#define resyncPageTables(context, startAddress, endAddress)
+#endif
+
 #endif /* __MEMORY_MANAGER__SHADOW_MAP_H__ */
@@ -1,3 +1,5 @@
+#include "cpuArch/armv7.h"
+
 #include "instructionEmu/interpreter.h"
 
 #include "perf/contextSwitchCounters.h"
@@ -165,6 +167,32 @@ void initCounters(PerfCounters* counters)
   counters->irqPriv = 0;
   counters->irqUser = 0;
 #endif
+#ifdef CONFIG_REGISTER_RETURN_ADDRESS_CACHE
+  counters->returnCacheFills = 0;
+  counters->returnCacheMisses = 0;
+  enableUserSoftwareCounter(RETURN_CACHE_HIT_COUNTER);
+#endif
+#ifdef CONFIG_REGISTER_PC_MAP
+  counters->pcMappings = 0;
+  counters->pcMapRescans = 0;
+#endif
+#ifdef CONFIG_REGISTER_TLB_FLUSHES
+  counters->tlbFlushesAvoided = 0;
+  counters->asidRollovers = 0;
+#endif
+#ifdef CONFIG_REGISTER_SOFTWARE_TLB
+  counters->softwareTLBHits = 0;
+  counters->softwareTLBMisses = 0;
+#endif
+#ifdef CONFIG_REGISTER_SHADOW_FAULTS
+  counters->shadowPageFaults = 0;
+  counters->faultAroundPages = 0;
+#endif
+#ifdef CONFIG_REGISTER_SHADOW_UNSYNC
+  counters->unsyncedPageTables = 0;
+  counters->resyncedPageTables = 0;
+  counters->reprotectedPageTables = 0;
+#endif
 }
 
 
@@ -342,6 +370,38 @@ void dumpCounters(const PerfCounters* counters)
   printf("irq  count: %08x\n", counters->irqCount);
   printf("irqPriv: %08x\n", counters->irqPriv);
   printf("irqUser: %08x\n", counters->irqUser);
+#endif
+#ifdef CONFIG_REGISTER_RETURN_ADDRESS_CACHE
+  printf("====================================\n");
+  printf("return cache fills: %08x\n", counters->returnCacheFills);
+  printf("return cache misses: %08x\n", counters->returnCacheMisses);
+  printf("return cache hits: %08x\n", readEventCounter(RETURN_CACHE_HIT_COUNTER));
+#endif
+#ifdef CONFIG_REGISTER_PC_MAP
+  printf("====================================\n");
+  printf("PC map lookups: %08x\n", counters->pcMappings);
+  printf("PC map rescans: %08x\n", counters->pcMapRescans);
+#endif
+#ifdef CONFIG_REGISTER_TLB_FLUSHES
+  printf("====================================\n");
+  printf("TLB flushes avoided: %08x\n", counters->tlbFlushesAvoided);
+  printf("ASID rollovers: %08x\n", counters->asidRollovers);
+#endif
+#ifdef CONFIG_REGISTER_SOFTWARE_TLB
+  printf("====================================\n");
+  printf("software TLB hits: %08x\n", counters->softwareTLBHits);
+  printf("software TLB misses: %08x\n", counters->softwareTLBMisses);
+#endif
+#ifdef CONFIG_REGISTER_SHADOW_FAULTS
+  printf("====================================\n");
+  printf("shadow page faults: %08x\n", counters->shadowPageFaults);
+  printf("pages mapped around faults: %08x\n", counters->faultAroundPages);
+#endif
+#ifdef CONFIG_REGISTER_SHADOW_UNSYNC
+  printf("====================================\n");
+  printf("page tables out of sync: %08x\n", counters->unsyncedPageTables);
+  printf("page tables resynchronised: %08x\n", counters->resyncedPageTables);
+  printf("page tables write-protected again: %08x\n", counters->reprotectedPageTables);
 #endif
   printf("====================================\n");
 }
@@ -164,6 +164,44 @@ typedef struct ContextSwitchCounters {
   u32int irqPriv;
   u32int irqUser;
 #endif
+#ifdef CONFIG_REGISTER_RETURN_ADDRESS_CACHE
+  /*
+   * return address cache entries filled when a block after a BL is translated, and returns that
+   * trapped into the hypervisor, including those to return sites never translated before. returns
+   * that hit are counted by translated code, in RETURN_CACHE_HIT_COUNTER.
+   */
+  u32int returnCacheFills;
+  u32int returnCacheMisses;
+#endif
+#ifdef CONFIG_REGISTER_PC_MAP
+  // host PCs mapped back to guest PCs with the PC map of a block, and by rescanning a block
+  u32int pcMappings;
+  u32int pcMapRescans;
+#endif
+#ifdef CONFIG_REGISTER_TLB_FLUSHES
+  // shadow page table switches that did not flush the TLB, and ASID generations used up
+  u32int tlbFlushesAvoided;
+  u32int asidRollovers;
+#endif
+#ifdef CONFIG_REGISTER_SOFTWARE_TLB
+  // translations of emulated accesses found in the software TLB, and page table walks
+  u32int softwareTLBHits;
+  u32int softwareTLBMisses;
+#endif
+#ifdef CONFIG_REGISTER_SHADOW_FAULTS
+  // guest small pages shadow mapped on a translation fault, and mapped ahead of one
+  u32int shadowPageFaults;
+  u32int faultAroundPages;
+#endif
+#ifdef CONFIG_REGISTER_SHADOW_UNSYNC
+  /*
+   * guest 2nd lvl page tables that stopped trapping writes, that were diffed against their copy,
+   * and that were write-protected again after a resync found them unchanged
+   */
+  u32int unsyncedPageTables;
+  u32int resyncedPageTables;
+  u32int reprotectedPageTables;
+#endif
 } PerfCounters;
 
 
@@ -804,4 +842,115 @@ __macro__ void registerIrq(PerfCounters* counters, bool user)
 #endif
 
 
+#ifdef CONFIG_REGISTER_RETURN_ADDRESS_CACHE
+/*
+ * performance monitor event counter incremented by the return address cache lookup on a hit, see
+ * armIndirectBranchLookup(). translated code runs unprivileged and cannot write to memory of ours.
+ */
+#define RETURN_CACHE_HIT_COUNTER  0
+
+void countReturnCacheFill(PerfCounters* counters);
+__macro__ void countReturnCacheFill(PerfCounters* counters)
+{
+  counters->returnCacheFills++;
+}
+void countReturnCacheMiss(PerfCounters* counters);
+__macro__ void countReturnCacheMiss(PerfCounters* counters)
+{
+  counters->returnCacheMisses++;
+}
+#else
+#define countReturnCacheFill(counters);
+#define countReturnCacheMiss(counters);
+#endif
+
+
+#ifdef CONFIG_REGISTER_PC_MAP
+void countPCMapping(PerfCounters* counters);
+__macro__ void countPCMapping(PerfCounters* counters)
+{
+  counters->pcMappings++;
+}
+void countPCMapRescan(PerfCounters* counters);
+__macro__ void countPCMapRescan(PerfCounters* counters)
+{
+  counters->pcMapRescans++;
+}
+#else
+#define countPCMapping(counters);
+#define countPCMapRescan(counters);
+#endif
+
+
+#ifdef CONFIG_REGISTER_TLB_FLUSHES
+void countTLBFlushAvoided(PerfCounters* counters);
+__macro__ void countTLBFlushAvoided(PerfCounters* counters)
+{
+  counters->tlbFlushesAvoided++;
+}
+void countASIDRollover(PerfCounters* counters);
+__macro__ void countASIDRollover(PerfCounters* counters)
+{
+  counters->asidRollovers++;
+}
+#else
+#define countTLBFlushAvoided(counters);
+#define countASIDRollover(counters);
+#endif
+
+#ifdef CONFIG_REGISTER_SOFTWARE_TLB
+void countSoftwareTLBHit(PerfCounters* counters);
+__macro__ void countSoftwareTLBHit(PerfCounters* counters)
+{
+  counters->softwareTLBHits++;
+}
+void countSoftwareTLBMiss(PerfCounters* counters);
+__macro__ void countSoftwareTLBMiss(PerfCounters* counters)
+{
+  counters->softwareTLBMisses++;
+}
+#else
+#define countSoftwareTLBHit(counters);
+#define countSoftwareTLBMiss(counters);
+#endif
+
+#ifdef CONFIG_REGISTER_SHADOW_FAULTS
+void countShadowPageFault(PerfCounters* counters);
+__macro__ void countShadowPageFault(PerfCounters* counters)
+{
+  counters->shadowPageFaults++;
+}
+void countFaultAroundPage(PerfCounters* counters);
+__macro__ void countFaultAroundPage(PerfCounters* counters)
+{
+  counters->faultAroundPages++;
+}
+#else
+#define countShadowPageFault(counters);
+#define countFaultAroundPage(counters);
+#endif
+
+#ifdef CONFIG_REGISTER_SHADOW_UNSYNC
+void countUnsyncedPageTable(PerfCounters* counters);
+__macro__ void countUnsyncedPageTable(PerfCounters* counters)
+{
+  counters->unsyncedPageTables++;
+}
+void countResyncedPageTable(PerfCounters* counters);
+__macro__ void countResyncedPageTable(PerfCounters* counters)
+{
+  counters->resyncedPageTables++;
+}
+void countReprotectedPageTable(PerfCounters* counters);
+__macro__ void countReprotectedPageTable(PerfCounters* counters)
+{
+  counters->reprotectedPageTables++;
+}
+#else
+#define countUnsyncedPageTable(counters);
+#define countResyncedPageTable(counters);
+#define countReprotectedPageTable(counters);
+#endif
+
+
 #endif
@@ -5,6 +5,7 @@
 
 #include "memoryManager/addressing.h"
 #include "memoryManager/mmu.h"
+#include "memoryManager/shadowMap.h"
 
 #include "vm/omap35xx/cp15coproc.h"
 
@@ -538,20 +539,25 @@ void setCregVal(GCONTXT *context, u32int registerIndex, u32int value)
       // ITLBIALL: invalide instruction TLB (all)
       DEBUG(INTERPRETER_ANY_COPROC, "setCregVal: invalidate instruction TLB (all)" EOL);
       mmuInvalidateITLB();
+      invalidateSoftwareTLB(context);
+      resyncPageTables(context, 0, 0xFFFFFFFF);
       break;
     }
     case CP15_ITLBIMVA:
     {
       // ITLBIMVA: invalide instruction TLB by MVA
       DEBUG(INTERPRETER_ANY_COPROC, "setCregVal: invalidate instruction TLB by MVA: %x" EOL, value);
-      mmuInvalidateITLBbyMVA(value);
+      // the guest ASID is not used on the host, see addressing.c
+      resyncPageTables(context, value, value);
+      invalidateShadowTLBbyMVA(context, value);
       break;
     }
     case CP15_ITLBIASID:
     {
       // ITLBIASID: invalide instruction TLB by ASID match
       DEBUG(INTERPRETER_ANY_COPROC, "setCregVal: invalidate instruction TLB by ASID match: %x" EOL, value);
-      mmuInvalidateITLBbyASID(value);
+      resyncPageTables(context, 0, 0xFFFFFFFF);
+      invalidateShadowTLB(context);
       break;
     }
     case CP15_DTLBIALL:
@@ -559,20 +565,24 @@ void setCregVal(GCONTXT *context, u32int registerIndex, u32int value)
       // DTLBIALL: invalide data TLB (all)
       DEBUG(INTERPRETER_ANY_COPROC, "setCregVal: invalidate data TLB (all)" EOL);
       mmuInvalidateDTLB();
+      invalidateSoftwareTLB(context);
+      resyncPageTables(context, 0, 0xFFFFFFFF);
       break;
     }
     case CP15_DTLBIMVA:
     {
       // DTLBIMVA: invalidate dTLB entry by MVA
       DEBUG(INTERPRETER_ANY_COPROC, "setCregVal: invalidate data TLB by MVA: %x" EOL, value);
-      mmuInvalidateDTLBbyMVA(value);
+      resyncPageTables(context, value, value);
+      invalidateShadowTLBbyMVA(context, value);
       break;
     }
     case CP15_DTLBIASID:
     {
       // DTLBIASID: invalidate dTLB entry by MVA
       DEBUG(INTERPRETER_ANY_COPROC, "setCregVal: invalidate data TLB by ASID match: %x" EOL, value);
-      mmuInvalidateDTLBbyASID(value);
+      resyncPageTables(context, 0, 0xFFFFFFFF);
+      invalidateShadowTLB(context);
       break;
     }
     case CP15_TLBIALL:
@@ -580,13 +590,16 @@ void setCregVal(GCONTXT *context, u32int registerIndex, u32int value)
       // TLBIALL: invalide unified TLB, write-only
       DEBUG(INTERPRETER_ANY_COPROC, "setCregVal: invalidate unified TLB (all)" EOL);
       mmuInvalidateUTLB();
+      invalidateSoftwareTLB(context);
+      resyncPageTables(context, 0, 0xFFFFFFFF);
       break;
     }
     case CP15_TLBIMVA:
     {
       // TLBIMVA: invalidate unified TLB by MVA, write-only
       DEBUG(INTERPRETER_ANY_COPROC, "setCregVal: invalidate unified TLB by MVA" EOL);
-      mmuInvalidateUTLBbyMVA(value);
+      resyncPageTables(context, value, value);
+      invalidateShadowTLBbyMVA(context, value);
       break;
     }
     case CP15_PRRR:
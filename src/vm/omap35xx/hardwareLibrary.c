@@ -37,11 +37,23 @@
 static bool attachDevice(device *parent, device *child) __cold__;
 static device *createDevice(const char *devName, bool isBus, u32int addrStart, u32int addrEnd,
                             device *parent, LOAD_FUNCTION ldFn, STORE_FUNCTION stFn) __cold__;
+static mmioDispatchTable *createDispatchTable(device *topLevelBus) __cold__;
+static bool addToDispatchTable(mmioDispatchTable *table, device *dev) __cold__;
+static inline device *lookupDevice(GCONTXT *context, u32int physAddr);
 static inline bool isAddressInDevice(u32int address, device *dev);
 static u32int loadGeneric(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr, u32int physAddr);
 static void storeGeneric(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr, u32int physAddr, u32int value);
 
 
+#ifdef CONFIG_REGISTER_MMIO_ACCESSES
+#define countDeviceLoad(dev)   ((dev)->loadCount++)
+#define countDeviceStore(dev)  ((dev)->storeCount++)
+#else
+#define countDeviceLoad(dev)
+#define countDeviceStore(dev)
+#endif
+
+
 static bool attachDevice(device *parent, device *child)
 {
   // only attach to 'bus' typed devices
@@ -411,6 +423,9 @@ device *createHardwareLibrary(GCONTXT *context)
   {
     goto timer32kError;
   }
+#ifdef CONFIG_TIMER32K_DIRECT_READ
+  timer32k->directRead = TRUE;
+#endif
   initTimer32k(&context->vm);
 #endif
 
@@ -516,12 +531,19 @@ device *createHardwareLibrary(GCONTXT *context)
     goto profilerError;
   }
 #endif
+
+  context->mmioDispatch = createDispatchTable(topLevelBus);
+  if (context->mmioDispatch == NULL)
+  {
+    goto mmioDispatchError;
+  }
   return topLevelBus;
 
   /*
    * Deallocation in reverse order to make sure no uninitialized pointer values are freed.
    * WARNING: this is required because pointers are NOT guaranteed to be NULL if uninitialized.
    */
+mmioDispatchError:
 #ifdef CONFIG_PROFILER
   free(profiler);
 profilerError:
@@ -626,11 +648,134 @@ topLevelBusError:
 }
 
 
+static mmioDispatchTable *createDispatchTable(device *topLevelBus)
+{
+  DEBUG(VP_OMAP_35XX_LIBRARY, "Building MMIO dispatch table" EOL);
+
+  mmioDispatchTable *table = (mmioDispatchTable *)calloc(1, sizeof(mmioDispatchTable));
+  if (table == NULL)
+  {
+    printf("Error: allocation of MMIO dispatch table failed" EOL);
+    return NULL;
+  }
+  if (!addToDispatchTable(table, topLevelBus))
+  {
+    u32int section;
+    for (section = 0; section < MMIO_DISPATCH_SECTIONS; section++)
+    {
+      free(table->pages[section]);
+    }
+    free(table);
+    return NULL;
+  }
+  return table;
+}
+
+/*
+ * Enters all end devices below dev in the dispatch table. A megabyte that one device covers
+ * completely takes a single entry; otherwise the megabyte is split into pages. Devices smaller
+ * than a page can share it with a neighbour; the first one entered gets the page and the others
+ * are found through the bus walk.
+ */
+static bool addToDispatchTable(mmioDispatchTable *table, device *dev)
+{
+  if (dev->isBus)
+  {
+    u32int index;
+    for (index = 0; index < dev->nrOfAttachedDevs; index++)
+    {
+      if (!addToDispatchTable(table, dev->attachedDevices[index]))
+      {
+        return FALSE;
+      }
+    }
+    return TRUE;
+  }
+
+  u32int page = dev->startAddressMapped >> MMIO_DISPATCH_PAGE_SHIFT;
+  u32int lastPage = dev->endAddressMapped >> MMIO_DISPATCH_PAGE_SHIFT;
+  for (; page <= lastPage; page++)
+  {
+    u32int section = page / MMIO_DISPATCH_PAGES;
+    u32int sectionStart = section << MMIO_DISPATCH_SECTION_SHIFT;
+    u32int sectionEnd = sectionStart + ((1 << MMIO_DISPATCH_SECTION_SHIFT) - 1);
+
+    if (table->pages[section] == NULL && table->sections[section] == NULL
+        && dev->startAddressMapped <= sectionStart && dev->endAddressMapped >= sectionEnd)
+    {
+      table->sections[section] = dev;
+      page += MMIO_DISPATCH_PAGES - 1;
+      continue;
+    }
+
+    if (table->pages[section] == NULL)
+    {
+      table->pages[section] = (device **)calloc(MMIO_DISPATCH_PAGES, sizeof(device *));
+      if (table->pages[section] == NULL)
+      {
+        printf("Error: allocation of MMIO dispatch pages for %s failed" EOL, dev->deviceName);
+        return FALSE;
+      }
+    }
+    if (table->pages[section][page % MMIO_DISPATCH_PAGES] == NULL)
+    {
+      table->pages[section][page % MMIO_DISPATCH_PAGES] = dev;
+    }
+  }
+  DEBUG(VP_OMAP_35XX_LIBRARY, "Dispatching %#.8x-%#.8x to %s" EOL, dev->startAddressMapped,
+        dev->endAddressMapped, dev->deviceName);
+  return TRUE;
+}
+
+static inline device *lookupDevice(GCONTXT *context, u32int physAddr)
+{
+  mmioDispatchTable *table = context->mmioDispatch;
+  u32int section = physAddr >> MMIO_DISPATCH_SECTION_SHIFT;
+  device *dev = NULL;
+  if (table->pages[section] != NULL)
+  {
+    dev = table->pages[section][(physAddr >> MMIO_DISPATCH_PAGE_SHIFT) % MMIO_DISPATCH_PAGES];
+  }
+  if (dev == NULL)
+  {
+    dev = table->sections[section];
+  }
+  return (dev != NULL && isAddressInDevice(physAddr, dev)) ? dev : NULL;
+}
+
 static inline bool isAddressInDevice(u32int address, device *dev)
 {
   return (address >= dev->startAddressMapped) && (address <= dev->endAddressMapped);
 }
 
+/*
+ * Reads from the end device at this physical address have no side effects and return the value of
+ * the hardware register, so the guest can be given read-only access to them.
+ */
+bool isDirectReadAddress(GCONTXT *context, u32int physAddr)
+{
+  device *dev = lookupDevice(context, physAddr);
+  return dev != NULL && dev->directRead;
+}
+
+void dumpDeviceCounters(device *dev)
+{
+#ifdef CONFIG_REGISTER_MMIO_ACCESSES
+  if (dev->isBus)
+  {
+    u32int index;
+    for (index = 0; index < dev->nrOfAttachedDevs; index++)
+    {
+      dumpDeviceCounters(dev->attachedDevices[index]);
+    }
+  }
+  else if (dev->loadCount != 0 || dev->storeCount != 0)
+  {
+    printf("%s: loads %08x stores %08x" EOL, dev->deviceName, dev->loadCount, dev->storeCount);
+  }
+#endif
+}
+
 
 /**************************************
  * generic LOAD/STORE functions       *
@@ -692,11 +837,25 @@ static void storeGeneric(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int
 u32int vmLoad(GCONTXT *gc, ACCESS_SIZE size, u32int virtAddr)
 {
   u32int physAddr = getPhysicalAddress(gc, gc->virtAddrEnabled ? gc->pageTables->shadowActive : gc->hypervisorPageTable, virtAddr);
-  return gc->hardwareLibrary->loadFunction(gc, gc->hardwareLibrary, size, virtAddr, physAddr);
+  device *dev = lookupDevice(gc, physAddr);
+  if (dev == NULL)
+  {
+    // not in the dispatch table, let the bus walk find the device or report the access
+    dev = gc->hardwareLibrary;
+  }
+  countDeviceLoad(dev);
+  return dev->loadFunction(gc, dev, size, virtAddr, physAddr);
 }
 
 void vmStore(GCONTXT *gc, ACCESS_SIZE size, u32int virtAddr, u32int value)
 {
   u32int physAddr = getPhysicalAddress(gc, gc->virtAddrEnabled ? gc->pageTables->shadowActive : gc->hypervisorPageTable, virtAddr);
-  gc->hardwareLibrary->storeFunction(gc, gc->hardwareLibrary, size, virtAddr, physAddr, value);
+  device *dev = lookupDevice(gc, physAddr);
+  if (dev == NULL)
+  {
+    // not in the dispatch table, let the bus walk find the device or report the access
+    dev = gc->hardwareLibrary;
+  }
+  countDeviceStore(dev);
+  dev->storeFunction(gc, dev, size, virtAddr, physAddr, value);
 }
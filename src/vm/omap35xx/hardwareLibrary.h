@@ -127,7 +127,25 @@
 #define PROFILER_SIZE             0x00002000
 #endif
 
+/*
+ * Flat index from physical address to end device, built once by createHardwareLibrary().
+ * Megabytes that belong to a single device have an entry in sections; megabytes shared by several
+ * devices are split into pages.
+ */
+#define MMIO_DISPATCH_SECTION_SHIFT  20
+#define MMIO_DISPATCH_SECTIONS       4096
+#define MMIO_DISPATCH_PAGE_SHIFT     12
+#define MMIO_DISPATCH_PAGES          256
+
+typedef struct MmioDispatchTable
+{
+  device *sections[MMIO_DISPATCH_SECTIONS];
+  device **pages[MMIO_DISPATCH_SECTIONS];
+} mmioDispatchTable;
+
 device *createHardwareLibrary(struct guestContext *context) __cold__;
+void dumpDeviceCounters(device *dev) __cold__;
+bool isDirectReadAddress(struct guestContext *context, u32int physAddr);
 u32int vmLoad(struct guestContext *gc, ACCESS_SIZE size, u32int virtAddr);
 void vmStore(struct guestContext *gc, ACCESS_SIZE size, u32int virtAddr, u32int value);
 
@@ -1,3 +1,4 @@
+#include "common/bit.h"
 #include "common/debug.h"
 #include "common/stddef.h"
 #include "common/stdlib.h"
@@ -12,11 +13,17 @@
 
 
 static u32int getIrqNumber(struct InterruptController* irqController);
+static u32int *getPendingIrqs(struct InterruptController *irqController, u32int bankNumber);
 static void intcReset(struct InterruptController *irqController);
 static bool isGuestIrqMasked(struct InterruptController *irqController, u32int interruptNumber);
 static void maskInterrupt(struct InterruptController *irqController, u32int interruptNumber);
 static u32int prioritySortIrqs(struct InterruptController *irqController);
+static void setIrqPriority(struct InterruptController *irqController, u32int irqNumber, u32int ilr);
+static void togglePendingIrqs(struct InterruptController *irqController, u32int priority,
+                              u32int bankNumber, u32int bitMask);
 static void unmaskInterrupt(struct InterruptController *irqController, u32int interruptNumber);
+static void updatePendingIrqs(struct InterruptController *irqController, u32int bankNumber,
+                              u32int pending);
 
 
 void initIntc(virtualMachine *vm)
@@ -143,98 +150,6 @@ u32int loadIntc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr
     case REG_INTCPS_PENDING_FIQ0:
     case REG_INTCPS_PENDING_FIQ1:
     case REG_INTCPS_PENDING_FIQ2:
-    case REG_INTCPS_ILR0:
-    case REG_INTCPS_ILR1:
-    case REG_INTCPS_ILR2:
-    case REG_INTCPS_ILR3:
-    case REG_INTCPS_ILR4:
-    case REG_INTCPS_ILR5:
-    case REG_INTCPS_ILR6:
-    case REG_INTCPS_ILR7:
-    case REG_INTCPS_ILR8:
-    case REG_INTCPS_ILR9:
-    case REG_INTCPS_ILR10:
-    case REG_INTCPS_ILR11:
-    case REG_INTCPS_ILR12:
-    case REG_INTCPS_ILR13:
-    case REG_INTCPS_ILR14:
-    case REG_INTCPS_ILR15:
-    case REG_INTCPS_ILR16:
-    case REG_INTCPS_ILR17:
-    case REG_INTCPS_ILR18:
-    case REG_INTCPS_ILR19:
-    case REG_INTCPS_ILR20:
-    case REG_INTCPS_ILR21:
-    case REG_INTCPS_ILR22:
-    case REG_INTCPS_ILR23:
-    case REG_INTCPS_ILR24:
-    case REG_INTCPS_ILR25:
-    case REG_INTCPS_ILR26:
-    case REG_INTCPS_ILR27:
-    case REG_INTCPS_ILR28:
-    case REG_INTCPS_ILR29:
-    case REG_INTCPS_ILR30:
-    case REG_INTCPS_ILR31:
-    case REG_INTCPS_ILR32:
-    case REG_INTCPS_ILR33:
-    case REG_INTCPS_ILR34:
-    case REG_INTCPS_ILR35:
-    case REG_INTCPS_ILR36:
-    case REG_INTCPS_ILR37:
-    case REG_INTCPS_ILR38:
-    case REG_INTCPS_ILR39:
-    case REG_INTCPS_ILR40:
-    case REG_INTCPS_ILR42:
-    case REG_INTCPS_ILR43:
-    case REG_INTCPS_ILR44:
-    case REG_INTCPS_ILR45:
-    case REG_INTCPS_ILR47:
-    case REG_INTCPS_ILR48:
-    case REG_INTCPS_ILR49:
-    case REG_INTCPS_ILR50:
-    case REG_INTCPS_ILR51:
-    case REG_INTCPS_ILR52:
-    case REG_INTCPS_ILR53:
-    case REG_INTCPS_ILR54:
-    case REG_INTCPS_ILR56:
-    case REG_INTCPS_ILR57:
-    case REG_INTCPS_ILR58:
-    case REG_INTCPS_ILR59:
-    case REG_INTCPS_ILR60:
-    case REG_INTCPS_ILR61:
-    case REG_INTCPS_ILR62:
-    case REG_INTCPS_ILR63:
-    case REG_INTCPS_ILR64:
-    case REG_INTCPS_ILR65:
-    case REG_INTCPS_ILR66:
-    case REG_INTCPS_ILR67:
-    case REG_INTCPS_ILR68:
-    case REG_INTCPS_ILR69:
-    case REG_INTCPS_ILR70:
-    case REG_INTCPS_ILR71:
-    case REG_INTCPS_ILR72:
-    case REG_INTCPS_ILR73:
-    case REG_INTCPS_ILR75:
-    case REG_INTCPS_ILR76:
-    case REG_INTCPS_ILR77:
-    case REG_INTCPS_ILR78:
-    case REG_INTCPS_ILR79:
-    case REG_INTCPS_ILR80:
-    case REG_INTCPS_ILR81:
-    case REG_INTCPS_ILR82:
-    case REG_INTCPS_ILR83:
-    case REG_INTCPS_ILR84:
-    case REG_INTCPS_ILR85:
-    case REG_INTCPS_ILR86:
-    case REG_INTCPS_ILR87:
-    case REG_INTCPS_ILR88:
-    case REG_INTCPS_ILR89:
-    case REG_INTCPS_ILR90:
-    case REG_INTCPS_ILR91:
-    case REG_INTCPS_ILR92:
-    case REG_INTCPS_ILR93:
-    case REG_INTCPS_ILR94:
-    case REG_INTCPS_ILR95:
     {
       printf("%s: offset %#x" EOL, __func__, regOffset);
       DIE_NOW(NULL, ERROR_NOT_IMPLEMENTED);
@@ -242,6 +157,11 @@ u32int loadIntc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr
     }
     default:
     {
+      if (regOffset >= REG_INTCPS_ILR0 && regOffset <= REG_INTCPS_ILR95)
+      {
+        val = irqController->intcIlr[(regOffset - REG_INTCPS_ILR0) >> 2];
+        break;
+      }
       printf("%s: offset %#x" EOL, __func__, regOffset);
       DIE_NOW(NULL, ERROR_NO_SUCH_REGISTER);
     }
@@ -363,7 +283,7 @@ void storeIntc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr,
         }
       }
       irqController->intcMir0 |= value;
-      irqController->intcPendingIrq0 = irqController->intcItr0 & ~irqController->intcMir0;
+      updatePendingIrqs(irqController, 0, irqController->intcItr0 & ~irqController->intcMir0);
       break;
     }
     case REG_INTCPS_MIR_SET1:
@@ -382,7 +302,7 @@ void storeIntc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr,
         }
       }
       irqController->intcMir1 |= value;
-      irqController->intcPendingIrq1 = irqController->intcItr1 & ~irqController->intcMir1;
+      updatePendingIrqs(irqController, 1, irqController->intcItr1 & ~irqController->intcMir1);
       break;
     }
     case REG_INTCPS_MIR_SET2:
@@ -396,7 +316,7 @@ void storeIntc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr,
         }
       }
       irqController->intcMir2 |= value;
-      irqController->intcPendingIrq2 = irqController->intcItr2 & ~irqController->intcMir2;
+      updatePendingIrqs(irqController, 2, irqController->intcItr2 & ~irqController->intcMir2);
       break;
     }
     case REG_INTCPS_CONTROL:
@@ -416,7 +336,7 @@ void storeIntc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr,
       break;
     case REG_INTCPS_MIR1:
       irqController->intcMir1 |= value;
-      irqController->intcPendingIrq1 = irqController->intcItr1 & ~irqController->intcMir1;
+      updatePendingIrqs(irqController, 1, irqController->intcItr1 & ~irqController->intcMir1);
       // If guest wants to enable GPT1, then GPT2 IRQ which is dedicated to guest must be unmasked
       if(!(value & 0x20 )) // bit 37(GPT1_IRQ)=0 -> IRQ Enable
       {
@@ -437,14 +357,9 @@ void storeIntc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr,
         unmaskInterruptBE(GPT1_IRQ);
       }
       break;
-    case REG_INTCPS_ILR37:
-      // FIXME this is FreeRTOS specific <- GPTIMER 2 delivers interrupt
-      irqController->intcIlr[37] = value & INTCPS_ILR_RESERVED;
-      break;
 #else
     case REG_INTCPS_MIR1:
     case REG_INTCPS_ISR_CLEAR1:
-    case REG_INTCPS_ILR37:
 #endif
     case REG_INTCPS_PROTECTION:
     case REG_INTCPS_IRQ_PRIORITY:
@@ -466,104 +381,21 @@ void storeIntc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr,
     case REG_INTCPS_PENDING_FIQ0:
     case REG_INTCPS_PENDING_FIQ1:
     case REG_INTCPS_PENDING_FIQ2:
-    case REG_INTCPS_ILR0:
-    case REG_INTCPS_ILR1:
-    case REG_INTCPS_ILR2:
-    case REG_INTCPS_ILR3:
-    case REG_INTCPS_ILR4:
-    case REG_INTCPS_ILR5:
-    case REG_INTCPS_ILR6:
-    case REG_INTCPS_ILR7:
-    case REG_INTCPS_ILR8:
-    case REG_INTCPS_ILR9:
-    case REG_INTCPS_ILR10:
-    case REG_INTCPS_ILR11:
-    case REG_INTCPS_ILR12:
-    case REG_INTCPS_ILR13:
-    case REG_INTCPS_ILR14:
-    case REG_INTCPS_ILR15:
-    case REG_INTCPS_ILR16:
-    case REG_INTCPS_ILR17:
-    case REG_INTCPS_ILR18:
-    case REG_INTCPS_ILR19:
-    case REG_INTCPS_ILR20:
-    case REG_INTCPS_ILR21:
-    case REG_INTCPS_ILR22:
-    case REG_INTCPS_ILR23:
-    case REG_INTCPS_ILR24:
-    case REG_INTCPS_ILR25:
-    case REG_INTCPS_ILR26:
-    case REG_INTCPS_ILR27:
-    case REG_INTCPS_ILR28:
-    case REG_INTCPS_ILR29:
-    case REG_INTCPS_ILR30:
-    case REG_INTCPS_ILR31:
-    case REG_INTCPS_ILR32:
-    case REG_INTCPS_ILR33:
-    case REG_INTCPS_ILR34:
-    case REG_INTCPS_ILR35:
-    case REG_INTCPS_ILR36:
-    case REG_INTCPS_ILR38:
-    case REG_INTCPS_ILR39:
-    case REG_INTCPS_ILR40:
-    case REG_INTCPS_ILR42:
-    case REG_INTCPS_ILR43:
-    case REG_INTCPS_ILR44:
-    case REG_INTCPS_ILR45:
-    case REG_INTCPS_ILR47:
-    case REG_INTCPS_ILR48:
-    case REG_INTCPS_ILR49:
-    case REG_INTCPS_ILR50:
-    case REG_INTCPS_ILR51:
-    case REG_INTCPS_ILR52:
-    case REG_INTCPS_ILR53:
-    case REG_INTCPS_ILR54:
-    case REG_INTCPS_ILR56:
-    case REG_INTCPS_ILR57:
-    case REG_INTCPS_ILR58:
-    case REG_INTCPS_ILR59:
-    case REG_INTCPS_ILR60:
-    case REG_INTCPS_ILR61:
-    case REG_INTCPS_ILR62:
-    case REG_INTCPS_ILR63:
-    case REG_INTCPS_ILR64:
-    case REG_INTCPS_ILR65:
-    case REG_INTCPS_ILR66:
-    case REG_INTCPS_ILR67:
-    case REG_INTCPS_ILR68:
-    case REG_INTCPS_ILR69:
-    case REG_INTCPS_ILR70:
-    case REG_INTCPS_ILR71:
-    case REG_INTCPS_ILR72:
-    case REG_INTCPS_ILR73:
-    case REG_INTCPS_ILR75:
-    case REG_INTCPS_ILR76:
-    case REG_INTCPS_ILR77:
-    case REG_INTCPS_ILR78:
-    case REG_INTCPS_ILR79:
-    case REG_INTCPS_ILR80:
-    case REG_INTCPS_ILR81:
-    case REG_INTCPS_ILR82:
-    case REG_INTCPS_ILR83:
-    case REG_INTCPS_ILR84:
-    case REG_INTCPS_ILR85:
-    case REG_INTCPS_ILR86:
-    case REG_INTCPS_ILR87:
-    case REG_INTCPS_ILR88:
-    case REG_INTCPS_ILR89:
-    case REG_INTCPS_ILR90:
-    case REG_INTCPS_ILR91:
-    case REG_INTCPS_ILR92:
-    case REG_INTCPS_ILR93:
-    case REG_INTCPS_ILR94:
-    case REG_INTCPS_ILR95:
     {
       printf("offset %x" EOL, regOffset);
       DIE_NOW(NULL, ERROR_NOT_IMPLEMENTED);
       break;
     }
     default:
+    {
+      if (regOffset >= REG_INTCPS_ILR0 && regOffset <= REG_INTCPS_ILR95)
+      {
+        setIrqPriority(irqController, (regOffset - REG_INTCPS_ILR0) >> 2,
+            value & INTCPS_ILR_RESERVED);
+        break;
+      }
       DIE_NOW(NULL, ERROR_NO_SUCH_REGISTER);
+    }
   }
 }
 
@@ -609,6 +441,8 @@ static void intcReset(struct InterruptController *irqController)
   {
     irqController->intcIlr[i] = 0;
   }
+  memset(irqController->intcPendingIrqByPriority, 0, sizeof(irqController->intcPendingIrqByPriority));
+  memset(irqController->intcPendingPriorities, 0, sizeof(irqController->intcPendingPriorities));
   // reset done flag
   irqController->intcSysStatus = irqController->intcSysStatus | INTCPS_SYSSTATUS_SOFTRESET;
 }
@@ -737,20 +571,7 @@ void setInterrupt(GCONTXT *context, u32int irqNum)
   if(!isGuestIrqMasked(irqController, irqNum))
   {
     // unmasked! set flag...
-    switch (bankNumber)
-    {
-      case 0:
-        irqController->intcPendingIrq0 |= bitMask;
-        break;
-      case 1:
-        irqController->intcPendingIrq1 |= bitMask;
-        break;
-      case 2:
-        irqController->intcPendingIrq2 |= bitMask;
-        break;
-      default:
-        DIE_NOW(NULL, "INTC: setInterrupt in invalid interrupt bank");
-    }
+    updatePendingIrqs(irqController, bankNumber, *getPendingIrqs(irqController, bankNumber) | bitMask);
   }
   // 3. leave priority sorting for now. it will be done when IRQ number gets read.
 }
@@ -787,103 +608,126 @@ void clearInterrupt(GCONTXT *context, u32int irqNum)
   }
 
   // 2. clear irq-after-masking reg just in case as well
+  updatePendingIrqs(irqController, bankNumber, *getPendingIrqs(irqController, bankNumber) & bitMask);
+}
+
+
+/*
+ * Besides the per-bank pending registers, pending IRQs are kept in one bitmap per priority level,
+ * and the levels that have IRQs pending in another bitmap. Priority 0 is the highest, so levels
+ * are kept in that bitmap in reverse order: bit INTCPS_NR_OF_PRIORITIES - 1 - priority. The highest
+ * priority pending IRQ is then found with two CLZs instead of a scan of all pending IRQs. All changes to the pending IRQ
+ * registers and to the priority of pending IRQs must go through updatePendingIrqs() and
+ * setIrqPriority() to keep these bitmaps up to date.
+ */
+
+static u32int *getPendingIrqs(struct InterruptController *irqController, u32int bankNumber)
+{
   switch (bankNumber)
   {
     case 0:
-      irqController->intcPendingIrq0 &= bitMask;
-      break;
+      return &irqController->intcPendingIrq0;
     case 1:
-      irqController->intcPendingIrq1 &= bitMask;
-      break;
+      return &irqController->intcPendingIrq1;
     case 2:
-      irqController->intcPendingIrq2 &= bitMask;
-      break;
+      return &irqController->intcPendingIrq2;
     default:
-      DIE_NOW(NULL, "INTC: setInterrupt in invalid interrupt bank");
+      DIE_NOW(NULL, "INTC: pending IRQs of invalid interrupt bank");
   }
+  // keep compiler quiet
+  return NULL;
 }
 
-
-// Function to look through all pending irqs and select highest priority one
-// return: interrupt number
-static u32int prioritySortIrqs(struct InterruptController *irqController)
+static void togglePendingIrqs(struct InterruptController *irqController, u32int priority,
+                              u32int bankNumber, u32int bitMask)
 {
-  if (!isIrqPending(irqController))
+  u32int *pending = irqController->intcPendingIrqByPriority[priority];
+  u32int level = INTCPS_NR_OF_PRIORITIES - 1 - priority;
+  u32int levelMask = 1 << (level % 32);
+
+  pending[bankNumber] ^= bitMask;
+  if ((pending[0] | pending[1] | pending[2]) != 0)
   {
-    // no interrupts pending.
-    return 0;
+    irqController->intcPendingPriorities[level / 32] |= levelMask;
   }
   else
   {
-    u32int currentHighestPriority = 0;
-    u32int currentIrqNumber = 0;
-    if (irqController->intcPendingIrq0 != 0)
-    {
-      u32int mask = 0;
-      u32int i = 0;
-      for (i = 0; i < 32; i++)
-      {
-        mask = 1 << i;
-        if ((irqController->intcPendingIrq0 & mask) != 0)
-        {
-          u32int priority = irqController->intcIlr[i];
-          DEBUG(VP_OMAP_35XX_INTC, "INTC: irq nr %#x is pending with priority %#x" EOL, i,
-              priority);
-          if (priority >= currentHighestPriority)
-          {
-            currentHighestPriority = priority;
-            currentIrqNumber = i;
-          }
-        }
-      }
-    }
+    irqController->intcPendingPriorities[level / 32] &= ~levelMask;
+  }
+}
 
-    if (irqController->intcPendingIrq1 != 0)
-    {
-      u32int mask = 0;
-      u32int i = 0;
-      for (i = 0; i < 32; i++)
-      {
-        mask = 1 << i;
-        if ((irqController->intcPendingIrq1 & mask) != 0)
-        {
-          u32int priority = irqController->intcIlr[i + 32];
-          DEBUG(VP_OMAP_35XX_INTC, "INTC: irq nr %#x is pending with priority %#x" EOL,
-              i + 32, priority);
-          if (priority >= currentHighestPriority)
-          {
-            currentHighestPriority = priority;
-            currentIrqNumber = i+32;
-          }
-        }
-      }
-    }
+static void updatePendingIrqs(struct InterruptController *irqController, u32int bankNumber,
+                              u32int pending)
+{
+  u32int *pendingIrqs = getPendingIrqs(irqController, bankNumber);
+  u32int changed = *pendingIrqs ^ pending;
 
-    if (irqController->intcPendingIrq2 != 0)
-    {
-      u32int mask = 0;
-      u32int i = 0;
-      for (i = 0; i < 32; i++)
-      {
-        mask = 1 << i;
-        if ((irqController->intcPendingIrq2 & mask) != 0)
-        {
-          u32int priority = irqController->intcIlr[i + 64];
-          DEBUG(VP_OMAP_35XX_INTC, "INTC: irq nr %#x is pending with priority %#x" EOL,
-              i + 64, priority);
-          if (priority >= currentHighestPriority)
-          {
-            currentHighestPriority = priority;
-            currentIrqNumber = i+64;
-          }
-        }
-      }
-    }
+  *pendingIrqs = pending;
+  while (changed != 0)
+  {
+    u32int bit = 31 - countLeadingZeros(changed);
+    u32int irqNumber = bankNumber * INTCPS_INTERRUPTS_PER_BANK + bit;
 
-    return currentIrqNumber;
+    changed &= ~(1 << bit);
+    togglePendingIrqs(irqController, irqController->intcIlr[irqNumber] >> INTCPS_ILR_PRIORITY_SHIFT,
+        bankNumber, 1 << bit);
   }
 }
 
+static void setIrqPriority(struct InterruptController *irqController, u32int irqNumber, u32int ilr)
+{
+  u32int bankNumber = irqNumber / INTCPS_INTERRUPTS_PER_BANK;
+  u32int bitMask = 1 << (irqNumber % INTCPS_INTERRUPTS_PER_BANK);
+  bool pending = (*getPendingIrqs(irqController, bankNumber) & bitMask) != 0;
+
+  DEBUG(VP_OMAP_35XX_INTC, "INTC: set priority of interrupt number %#x to %#x" EOL, irqNumber,
+      ilr >> INTCPS_ILR_PRIORITY_SHIFT);
+  if (pending)
+  {
+    togglePendingIrqs(irqController, irqController->intcIlr[irqNumber] >> INTCPS_ILR_PRIORITY_SHIFT,
+        bankNumber, bitMask);
+  }
+  irqController->intcIlr[irqNumber] = ilr;
+  if (pending)
+  {
+    togglePendingIrqs(irqController, ilr >> INTCPS_ILR_PRIORITY_SHIFT, bankNumber, bitMask);
+  }
+}
+
+/*
+ * Selects the pending IRQ with the highest priority, i.e. the lowest priority value; of those, the
+ * one with the highest number is selected. Returns its number, or 0 if no IRQ is pending.
+ */
+static u32int prioritySortIrqs(struct InterruptController *irqController)
+{
+  u32int word = INTCPS_NR_OF_PRIORITIES / 32;
+  while (word > 0 && irqController->intcPendingPriorities[word - 1] == 0)
+  {
+    word--;
+  }
+  if (word == 0)
+  {
+    // no interrupts pending.
+    return 0;
+  }
+  word--;
+
+  u32int level = word * 32 + 31 - countLeadingZeros(irqController->intcPendingPriorities[word]);
+  u32int priority = INTCPS_NR_OF_PRIORITIES - 1 - level;
+  u32int *pending = irqController->intcPendingIrqByPriority[priority];
+  u32int bankNumber = INTCPS_NR_OF_BANKS - 1;
+  while (pending[bankNumber] == 0)
+  {
+    bankNumber--;
+  }
+
+  u32int irqNumber = bankNumber * INTCPS_INTERRUPTS_PER_BANK + 31
+                   - countLeadingZeros(pending[bankNumber]);
+  DEBUG(VP_OMAP_35XX_INTC, "INTC: irq nr %#x is pending with priority %#x" EOL, irqNumber,
+      priority);
+  return irqNumber;
+}
+
 
 bool isIrqPending(struct InterruptController* irqController)
 {
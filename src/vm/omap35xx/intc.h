@@ -162,6 +162,9 @@ struct InterruptController
   u32int intcPendingFiq1;
   u32int intcPendingFiq2;
   u32int intcIlr[96];
+  /* pending IRQs for each priority level, and the levels that have IRQs pending, see intc.c */
+  u32int intcPendingIrqByPriority[64][3];
+  u32int intcPendingPriorities[2];
 };
 
 
@@ -4,6 +4,7 @@
 #define INTCPS_NR_OF_BANKS          3
 #define INTCPS_INTERRUPTS_PER_BANK 32
 #define INTCPS_NR_OF_INTERRUPTS    96
+#define INTCPS_NR_OF_PRIORITIES    64
 
 #define INTC_REVISION                                  0x00000040
 
@@ -119,6 +120,7 @@
 #define INTCPS_PENDING_FIQ2_PENDINGFIQ  0xFFFFFFFF // [31:0] fiq status after masking
 
 #define INTCPS_ILR_RESERVED  0xFC // Reserved bits 31-8 & bit 1
+#define INTCPS_ILR_PRIORITY_SHIFT  2 // [7:2] interrupt priority
 
 #define REG_INTCPS_ILR0           0x00000100 // RW contains the priority for the interrupts and the FIQ/IRQ steering
 #define REG_INTCPS_ILR1           0x00000104 //
@@ -7,6 +7,7 @@ HYPARM_SRCS_C-y += vm/omap35xx/gpio.c
 HYPARM_SRCS_C-y += vm/omap35xx/gptimer.c
 HYPARM_SRCS_C-y += vm/omap35xx/intc.c
 HYPARM_SRCS_C-y += vm/omap35xx/prm.c
+HYPARM_SRCS_C-y += vm/omap35xx/registerMap.c
 HYPARM_SRCS_C-y += vm/omap35xx/sdma.c
 HYPARM_SRCS_C-y += vm/omap35xx/sysControlModule.c
 HYPARM_SRCS_C-y += vm/omap35xx/timer32k.c
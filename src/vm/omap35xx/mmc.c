@@ -13,6 +13,7 @@
 
 #include "io/mmc.h"
 
+#include "memoryManager/addressing.h"
 #include "memoryManager/pageTable.h"
 #include "memoryManager/mmu.h"
 
@@ -221,7 +222,8 @@ void mmcStartDmaTransfer(GCONTXT *context, u32int phyAddr, u32int id, bool read)
   }
   
   if (replacedTTBR0) {
-    mmuSetTTBR0(context->pageTables->shadowActive, context->pageTables->contextID);
+    mmuSetTTBR0(context->pageTables->shadowActive,
+                getHostContextID(context, context->pageTables->shadowActive));
   }
   
   context->vm.sdma->chIndexedRegs[dmaChannel].ccfn = noOfTransferredBlocks;
@@ -355,7 +357,8 @@ void storeMmc(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr,
             *(targetAddress++) = 01;
             
             if (replacedTTBR0) {
-              mmuSetTTBR0(context->pageTables->shadowActive, context->pageTables->contextID);
+              mmuSetTTBR0(context->pageTables->shadowActive,
+                getHostContextID(context, context->pageTables->shadowActive));
             }
             
             mmc[id]->mmcRsp10 = 0;            
@@ -548,7 +551,8 @@ void mmcContinueDmaTransfer(GCONTXT *context, u32int id, u32int dmaChannel, bool
     }
     
     if (replacedTTBR0) {
-      mmuSetTTBR0(context->pageTables->shadowActive, context->pageTables->contextID);
+      mmuSetTTBR0(context->pageTables->shadowActive,
+                getHostContextID(context, context->pageTables->shadowActive));
     }
     
     context->vm.sdma->chIndexedRegs[dmaChannel].ccfn += noOfBlocksDma;
@@ -5,99 +5,19 @@
 #include "common/types.h"
 
 #include "vm/types.h"
+#include "vm/omap35xx/registerMap.h"
 
 
+/* PRM module instances are 256 byte blocks of registers, from IVA2_PRM up to USBHOST_PRM */
+#define PRM_MODULE_SIZE          0x100
+#define PRM_NUMBER_OF_SLOTS      0x15
+#define PRM_NUMBER_OF_MODULES    14
+
 struct PowerAndResetManager
 {
-  // registers
-  // Clock Control registers
-  u32int prmClkSelReg;
-  u32int prmClkoutCtrlReg;
-  // Global reg prm registers
-  u32int prmVcSmpsSa;
-  u32int prmVcSmpsVolRa;
-  u32int prmVcSmpsCmdRa;
-  u32int prmVcCmdVal0;
-  u32int prmVcCmdVal1;
-  u32int prmVcChConf;
-  u32int prmVcI2cCfg;
-  u32int prmVcBypassVal;
-  u32int prmRstCtrl;
-  u32int prmRstTime;
-  u32int prmRstState;
-  u32int prmVoltCtrl;
-  u32int prmSramPcharge;
-  u32int prmClkSrcCtrl;
-  u32int prmObsr;
-  u32int prmVoltSetup1;
-  u32int prmVoltOffset;
-  u32int prmClkSetup;
-  u32int prmPolCtrl;
-  u32int prmVoltSetup2;
-  // IVA2 registers
-  u32int prmRstctrlIva2;
-  u32int prmRststIva2;
-  u32int prmWkdepIva2;
-  u32int prmPwstctrlIva2;
-  u32int prmPwststIva2;
-  // OCP_system_reg registers
-  u32int prmRevisionOcp;
-  u32int prmSysConfigOcp;
-  u32int prmIrqStatusMpuOcp;
-  u32int prmIrqEnableMpuOcp;
-  // MPU registers
-  u32int prmRststMpu;
-  u32int prmWkdepMpu;
-  u32int prmPwstctrlMpu;
-  u32int prmPwststMpu;
-  // CORE registers
-  u32int prmRststCore;
-  u32int prmIva2grpselCore;
-  u32int prmPwstctrlCore;
-  u32int prmPwststCore;
-  u32int prmIva2grpsel3Core;
-  // SGX registers
-  u32int prmRststSgx;
-  u32int prmWkdepSgx;
-  u32int prmPwstctrlSgx;
-  u32int prmPwststSgx;
-  // Wakeup registers
-  u32int prmWkenWkup;
-  u32int prmMpugrpselWkup;
-  u32int prmIva2grpselWkup;
-  u32int prmWkstWkup;
-  // DSS registers
-  u32int prmRststDss;
-  u32int prmWkenDss;
-  u32int prmWkdepDss;
-  u32int prmPwstctrlDss;
-  u32int prmPwststDss;
-  // CAM registers
-  u32int prmRststCam;
-  u32int prmWkdepCam;
-  u32int prmPwstctrlCam;
-  u32int prmPwststCam;
-  // PER registers
-  u32int prmRststPer;
-  u32int prmWkenPer;
-  u32int prmMpugrpselPer;
-  u32int prmIva2grpselPer;
-  u32int prmWkdepPer;
-  u32int prmPwstctrlPer;
-  u32int prmPwststPer;
-  // EMU registers
-  u32int prmRststEmu;
-  u32int prmPwststEmu;
-  // NEON registers
-  u32int prmRststNeon;
-  u32int prmWkdepNeon;
-  u32int prmPwstctrlNeon;
-  u32int prmPwststNeon;
-  // USBHOST registers
-  u32int prmRststUsbhost;
-  u32int prmWkdepUsbhost;
-  u32int prmPwstctrlUsbhost;
-  u32int prmPwststUsbhost;
+  struct RegisterMap modules[PRM_NUMBER_OF_MODULES];
+  // module covering each 256 byte slot, NULL where there is none
+  struct RegisterMap *slots[PRM_NUMBER_OF_SLOTS];
 };
 
 
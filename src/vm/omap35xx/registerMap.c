@@ -0,0 +1,91 @@
+#include "common/debug.h"
+#include "common/stddef.h"
+#include "common/stdlib.h"
+
+#include "vm/omap35xx/registerMap.h"
+
+
+static const struct RegisterDescriptor *getDescriptor(struct RegisterMap *map, u32int offset);
+
+
+void initRegisterMap(struct RegisterMap *map, const struct RegisterBlock *block, void *device)
+{
+  const u32int numberOfWords = (block->size + 3) / 4;
+
+  map->block = block;
+  map->device = device;
+  map->descriptors = (const struct RegisterDescriptor **)calloc(numberOfWords, sizeof(struct RegisterDescriptor *));
+  map->values = (u32int *)calloc(numberOfWords, sizeof(u32int));
+  if (map->descriptors == NULL || map->values == NULL)
+  {
+    DIE_NOW(NULL, "Failed to allocate register map.");
+  }
+
+  u32int i;
+  for (i = 0; i < block->numberOfRegisters; i++)
+  {
+    const struct RegisterDescriptor *reg = &block->registers[i];
+    if ((reg->offset & 0x3) || (reg->offset >= block->size) || (map->descriptors[reg->offset >> 2] != NULL))
+    {
+      printf("%s: bad register %s at offset %#x" EOL, block->name, reg->name, reg->offset);
+      DIE_NOW(NULL, "Invalid register map.");
+    }
+    map->descriptors[reg->offset >> 2] = reg;
+  }
+
+  resetRegisterMap(map);
+}
+
+void resetRegisterMap(struct RegisterMap *map)
+{
+  const struct RegisterBlock *block = map->block;
+  u32int i;
+  for (i = 0; i < block->numberOfRegisters; i++)
+  {
+    REGISTER_VALUE(map, block->registers[i].offset) = block->registers[i].resetValue;
+  }
+}
+
+static const struct RegisterDescriptor *getDescriptor(struct RegisterMap *map, u32int offset)
+{
+  const struct RegisterDescriptor *reg = NULL;
+  if (offset < map->block->size)
+  {
+    reg = map->descriptors[offset >> 2];
+  }
+  if (reg == NULL)
+  {
+    printf("%s: offset %#x" EOL, map->block->name, offset);
+    DIE_NOW(NULL, ERROR_NO_SUCH_REGISTER);
+  }
+  return reg;
+}
+
+u32int loadRegister(struct RegisterMap *map, u32int offset)
+{
+  // dies on offsets without a register
+  getDescriptor(map, offset);
+  return REGISTER_VALUE(map, offset);
+}
+
+void storeRegister(struct RegisterMap *map, u32int offset, u32int value)
+{
+  const struct RegisterDescriptor *reg = getDescriptor(map, offset);
+  const u32int previous = REGISTER_VALUE(map, offset);
+  const u32int fixedBits = ~(reg->writeMask | reg->clearMask);
+
+  if (((previous & fixedBits) != (value & fixedBits)) && (reg->flags & REGISTER_STORE_FATAL))
+  {
+    printf("%s: store to %s value %#.8x" EOL, map->block->name, reg->name, value);
+    DIE_NOW(NULL, ERROR_NOT_IMPLEMENTED);
+  }
+
+  REGISTER_VALUE(map, offset) = (previous & fixedBits)
+                              | (value & reg->writeMask)
+                              | (previous & reg->clearMask & ~value);
+
+  if (reg->storeHook != NULL)
+  {
+    reg->storeHook(map->device, previous, value);
+  }
+}
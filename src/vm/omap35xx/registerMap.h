@@ -0,0 +1,111 @@
+#ifndef __VM__OMAP_35XX__REGISTER_MAP_H__
+#define __VM__OMAP_35XX__REGISTER_MAP_H__
+
+#include "common/compiler.h"
+#include "common/types.h"
+
+
+/*
+ * Declarative model of a block of 32-bit memory-mapped registers.
+ *
+ * Each register is described by its offset in the block, its reset value and the bits a store
+ * changes. Stores to the other bits are ignored. Registers that need more than that get a hook,
+ * which is called after every store. Accesses are traced by the device models, under their own
+ * CONFIG_DEBUG_* symbol.
+ *
+ * Loads and stores through a register map are a lookup in a table indexed by the word offset of
+ * the register, followed by a masked array access.
+ */
+
+/*
+ * Called after a store to a register; previous is the register value before the store, value is
+ * the value stored by the guest. The register itself already holds the masked result.
+ */
+typedef void (*registerStoreHook)(void *device, u32int previous, u32int value);
+
+struct RegisterDescriptor
+{
+  u32int offset;
+  u32int resetValue;
+  // bits changed by a store
+  u32int writeMask;
+  // bits cleared by storing 1 to them
+  u32int clearMask;
+  u32int flags;
+  registerStoreHook storeHook;
+  const char *name;
+};
+
+/* stores that would change the value of the register are not implemented */
+#define REGISTER_STORE_FATAL  0x1
+
+/* the shorthands stringify their offset argument themselves, before it is macro-expanded */
+#define REGISTER_DESCRIPTOR(offset, name, reset, writeMask, clearMask, flags, hook)                \
+  { (offset), (reset), (writeMask), (clearMask), (flags), (hook), name }
+
+#define REGISTER(offset, reset, writeMask, clearMask, flags, hook)                                 \
+  REGISTER_DESCRIPTOR(offset, #offset, reset, writeMask, clearMask, flags, hook)
+
+/* read/write register */
+#define REGISTER_RW(offset, reset)                                                                 \
+  REGISTER_DESCRIPTOR(offset, #offset, reset, 0xFFFFFFFF, 0, 0, NULL)
+/* register of which only the bits in mask can be changed */
+#define REGISTER_MASKED(offset, reset, mask)                                                       \
+  REGISTER_DESCRIPTOR(offset, #offset, reset, mask, 0, 0, NULL)
+/* register of which the bits in mask are cleared by writing 1 to them */
+#define REGISTER_W1C(offset, reset, mask)                                                          \
+  REGISTER_DESCRIPTOR(offset, #offset, reset, 0, mask, 0, NULL)
+/* register of which the value is kept, stores are ignored */
+#define REGISTER_IGNORED(offset, reset)                                                            \
+  REGISTER_DESCRIPTOR(offset, #offset, reset, 0, 0, 0, NULL)
+/* register of which only the reset value is emulated */
+#define REGISTER_RO(offset, reset)                                                                 \
+  REGISTER_DESCRIPTOR(offset, #offset, reset, 0, 0, REGISTER_STORE_FATAL, NULL)
+/* register with a store hook */
+#define REGISTER_HOOK(offset, reset, mask, hook)                                                   \
+  REGISTER_DESCRIPTOR(offset, #offset, reset, mask, 0, 0, hook)
+
+
+struct RegisterBlock
+{
+  const char *name;
+  u32int baseAddress;
+  u32int size;
+  const struct RegisterDescriptor *registers;
+  u32int numberOfRegisters;
+};
+
+#define REGISTER_BLOCK(name, base, size, registers)                                                \
+  { name, (base), (size), (registers), sizeof(registers) / sizeof(struct RegisterDescriptor) }
+
+
+struct RegisterMap
+{
+  const struct RegisterBlock *block;
+  void *device;
+  // one entry per word in the block, NULL where there is no register
+  const struct RegisterDescriptor **descriptors;
+  u32int *values;
+};
+
+/* value of the register at the given offset, for use by store hooks */
+#define REGISTER_VALUE(map, offset)  ((map)->values[(offset) >> 2])
+/* name of the register at the given offset, for tracing accesses */
+#define REGISTER_NAME(map, offset)   ((map)->descriptors[(offset) >> 2]->name)
+
+
+void initRegisterMap(struct RegisterMap *map, const struct RegisterBlock *block, void *device) __cold__;
+void resetRegisterMap(struct RegisterMap *map);
+
+u32int loadRegister(struct RegisterMap *map, u32int offset);
+void storeRegister(struct RegisterMap *map, u32int offset, u32int value);
+
+__macro__ bool isInRegisterMap(const struct RegisterMap *map, u32int physicalAddress);
+
+
+__macro__ bool isInRegisterMap(const struct RegisterMap *map, u32int physicalAddress)
+{
+  return physicalAddress - map->block->baseAddress < map->block->size;
+}
+
+#endif /* __VM__OMAP_35XX__REGISTER_MAP_H__ */
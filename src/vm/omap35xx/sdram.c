@@ -3,6 +3,8 @@
 #include "common/stdlib.h"
 #include "common/string.h"
 
+#include "memoryManager/shadowMap.h"
+
 #include "vm/omap35xx/sdram.h"
 
 
@@ -114,6 +116,9 @@ void storeSdram(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr
         {
           pageTableEdit(context, virtAddr, value);
         }
+#ifdef CONFIG_SHADOW_PAGE_TABLE_CACHE
+        trackCachedPageTableWrite(context, phyAddr, *(u32int *)virtAddr, value);
+#endif
       }
       // store the value...
       u32int * memPtr = (u32int*)virtAddr;
@@ -6,6 +6,10 @@
 #include "guestManager/guestContext.h"
 #include "guestManager/guestExceptions.h"
 
+#ifdef CONFIG_UART_TX_BUFFER
+#include "drivers/beagle/beUart.h"
+#endif
+
 #include "vm/omap35xx/intc.h"
 #include "vm/omap35xx/uart.h"
 #include "vm/omap35xx/uartInternals.h"
@@ -18,6 +22,13 @@ static void setUartMode(struct Uart *uart);
 static void resetUart(struct Uart *uart);
 static u8int uartRxByte(GCONTXT *context, struct Uart *uart, u32int id);
 static void uartTxByte(struct Uart *uart, u8int byte);
+#if defined(CONFIG_UART_TX_BUFFER) && !defined(CONFIG_UART_TX_DECOUPLED)
+static u32int getTxStatus(void);
+#define isTxEmpty()  ((getTxStatus() & UART_LSR_TX_FIFO_E) != 0)
+#else
+/* the guest never sees the transmitter busy, see uartTxByte() */
+#define isTxEmpty()  TRUE
+#endif
 
 
 void initUart(virtualMachine *vm, u32int uartID)
@@ -181,8 +192,11 @@ u32int loadUart(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr
       else
       {
         // load LSR
-        DEBUG(VP_OMAP_35XX_UART, "%s: load line status %#.8x" EOL, dev->deviceName, uart->lsr);
         value = uart->lsr;
+#if defined(CONFIG_UART_TX_BUFFER) && !defined(CONFIG_UART_TX_DECOUPLED)
+        value = (value & ~(UART_LSR_TX_FIFO_E | UART_LSR_TX_SR_E)) | getTxStatus();
+#endif
+        DEBUG(VP_OMAP_35XX_UART, "%s: load line status %#.8x" EOL, dev->deviceName, value);
       }
       break;
     }
@@ -296,6 +310,29 @@ void storeUart(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr,
       {
         // store THR
         uartTxByte(uart, (u8int)value);
+#if defined(CONFIG_UART_TX_BUFFER) && !defined(CONFIG_UART_TX_DECOUPLED)
+        if (!isTxEmpty() && ((uart->iir & UART_IIR_IT_PENDING) == 0)
+            && ((uart->iir & UART_IIR_IT_TYPE) == (UART_IIR_IT_TYPE_THR_IRQ << UART_IIR_IT_TYPE_SHAMT)))
+        {
+          // no room for another TX FIFO's worth; uartTxSpaceAvailable() raises it again
+          uart->iir = uart->iir | UART_IIR_IT_PENDING;
+          uart->iir &= ~UART_IIR_IT_TYPE;
+          switch (uID)
+          {
+            case 0:
+              clearInterrupt(context, UART1_IRQ);
+              break;
+            case 1:
+              clearInterrupt(context, UART2_IRQ);
+              break;
+            case 2:
+              clearInterrupt(context, UART3_IRQ);
+              break;
+            default:
+              DIE_NOW(NULL, "store to uart: invalid uID.");
+          }
+        }
+#endif
       }
       else
       {
@@ -645,8 +682,8 @@ static void setUartMode(struct Uart *uart)
 
 /*
  * function called when guest writes to THR register.
- * immediatelly transmits character to native serial
- * unless emulation configured to be in loopback mode
+ * immediatelly transmits character to native serial (or queues it for the native serial, with
+ * CONFIG_UART_TX_BUFFER) unless emulation configured to be in loopback mode
  */
 static void uartTxByte(struct Uart *uart, u8int byte)
 {
@@ -678,14 +715,80 @@ static void uartTxByte(struct Uart *uart, u8int byte)
   }
   else
   {
+#ifdef CONFIG_UART_TX_BUFFER
+    // drained from the native serial interrupt. unless CONFIG_UART_TX_DECOUPLED is set, the
+    // TX bits in LSR follow the native serial, see getTxStatus()
+    serialPutcAsync((char)byte);
+#else
     // don't need to adjust TX bits in LSR, as we will always
     // finish transmitting this character first, before going back to guest
     // therefore, the non-existant TX FIFO is trully always empty.
     printf("%c", (s32int)byte);
+#endif
+  }
+}
+
+
+#if defined(CONFIG_UART_TX_BUFFER) && !defined(CONFIG_UART_TX_DECOUPLED)
+/*
+ * all emulated UARTs transmit through the native serial TX ring. the emulated TX FIFO is empty
+ * while the ring has room for a whole TX FIFO, and the shift register once the ring is drained.
+ */
+static u32int getTxStatus()
+{
+  u32int status = 0;
+  if (serialOutputSpace() >= TX_FIFO_SIZE)
+  {
+    status |= UART_LSR_TX_FIFO_E;
+  }
+  if (serialOutputPending() == 0)
+  {
+    status |= UART_LSR_TX_SR_E;
   }
+  return status;
 }
 
 
+/*
+ * function called from outside, after the native serial TX ring was drained.
+ * raises the THR irq of emulated UARTs that are waiting for the TX FIFO to empty.
+ */
+void uartTxSpaceAvailable(GCONTXT *context)
+{
+  if (!isTxEmpty())
+  {
+    return;
+  }
+
+  u32int uID;
+  for (uID = 0; uID < 3; uID++)
+  {
+    struct Uart* uart = context->vm.uart[uID];
+    if ((uart == NULL) || ((uart->ier & UART_IER_THR) == 0)
+        || ((uart->iir & UART_IIR_IT_PENDING) == 0))
+    {
+      continue;
+    }
+    uart->iir = uart->iir & ~UART_IIR_IT_PENDING;
+    uart->iir &= ~UART_IIR_IT_TYPE;
+    uart->iir = uart->iir | (UART_IIR_IT_TYPE_THR_IRQ << UART_IIR_IT_TYPE_SHAMT);
+    switch (uID)
+    {
+      case 0:
+        throwInterrupt(context, UART1_IRQ);
+        break;
+      case 1:
+        throwInterrupt(context, UART2_IRQ);
+        break;
+      case 2:
+        throwInterrupt(context, UART3_IRQ);
+        break;
+    }
+  }
+}
+#endif
+
+
 /*
  * function called when guest reads from RHR register.
  * gets a byte out of RHR/RX FIFO, adjust IRQ bits and LSR
@@ -726,9 +829,9 @@ static u8int uartRxByte(GCONTXT *context, struct Uart *uart, u32int id)
         // RX IRQ was enabled. probably need to clear it.
         uart->iir = uart->iir | UART_IIR_IT_PENDING;
         uart->iir &= ~UART_IIR_IT_TYPE;
-        if ( (uart->ier & UART_IER_THR) == UART_IER_THR )
+        if (((uart->ier & UART_IER_THR) == UART_IER_THR) && isTxEmpty())
         {
-          // TX fifo is always empty, set new IRQ type
+          // TX fifo is empty, set new IRQ type
           uart->iir = uart->iir & ~UART_IIR_IT_PENDING;
           uart->iir &= ~UART_IIR_IT_TYPE;
           uart->iir = uart->iir | (UART_IIR_IT_TYPE_THR_IRQ << UART_IIR_IT_TYPE_SHAMT);
@@ -878,10 +981,10 @@ void uartPutRxByte(GCONTXT *context, u8int byte, u32int uartID)
 static void setIrqFlags(GCONTXT *context, struct Uart *uart, u32int id, u32int flags)
 {
   if (((uart->ier & UART_IER_THR) == 0) &&
-      ((flags & UART_IER_THR) == UART_IER_THR))
+      ((flags & UART_IER_THR) == UART_IER_THR) && isTxEmpty())
   {
     // enabling TX IRQ!
-    // TX fifo is always empty. raise IRQ
+    // TX fifo is empty. raise IRQ
     uart->iir = uart->iir & ~UART_IIR_IT_PENDING;
     uart->iir &= ~UART_IIR_IT_TYPE;
     uart->iir = uart->iir | (UART_IIR_IT_TYPE_THR_IRQ << UART_IIR_IT_TYPE_SHAMT);
@@ -947,9 +1050,9 @@ static void setIrqFlags(GCONTXT *context, struct Uart *uart, u32int id, u32int f
     uart->iir = uart->iir | UART_IIR_IT_PENDING;
     uart->iir = uart->iir &~ UART_IIR_IT_TYPE;
 
-    if ( (flags & UART_IER_THR) == UART_IER_THR )
+    if (((flags & UART_IER_THR) == UART_IER_THR) && isTxEmpty())
     {
-      // TX fifo is always empty, set new IRQ type
+      // TX fifo is empty, set new IRQ type
       uart->iir = uart->iir & ~UART_IIR_IT_PENDING;
       uart->iir &= ~UART_IIR_IT_TYPE;
       uart->iir = uart->iir | (UART_IIR_IT_TYPE_THR_IRQ << UART_IIR_IT_TYPE_SHAMT);
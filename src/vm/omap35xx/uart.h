@@ -8,6 +8,7 @@
 
 
 #define RX_FIFO_SIZE    64
+#define TX_FIFO_SIZE    64
 
 
 /* possible modes of operation: operational, configA and configB. */
@@ -61,5 +62,10 @@ void initUart(virtualMachine *vm, u32int uartID) __cold__;
 u32int loadUart(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr, u32int phyAddr);
 void storeUart(GCONTXT *context, device *dev, ACCESS_SIZE size, u32int virtAddr, u32int phyAddr, u32int value);
 void uartPutRxByte(GCONTXT *context, u8int byte, u32int uardID);
+#if defined(CONFIG_UART_TX_BUFFER) && !defined(CONFIG_UART_TX_DECOUPLED)
+void uartTxSpaceAvailable(GCONTXT *context);
+#else
+#define uartTxSpaceAvailable(context)
+#endif
 
 #endif /* __VM__OMAP35XX__UART_H__ */
@@ -23,6 +23,12 @@ struct genericDevice
   device *attachedDevices[MAX_NR_ATTACHED];
   LOAD_FUNCTION loadFunction;
   STORE_FUNCTION storeFunction;
+  /* guest may read the registers of this end device directly, see shadowMapSection() */
+  bool directRead;
+#ifdef CONFIG_REGISTER_MMIO_ACCESSES
+  u32int loadCount;
+  u32int storeCount;
+#endif
 };
 
 typedef struct EmulatedVirtualMachine virtualMachine;
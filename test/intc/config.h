@@ -0,0 +1,18 @@
+/*
+ * Configuration for the host build of the interrupt controller test. This takes the place of the
+ * header generated by kconfig; only symbols used by the sources linked into the test are set.
+ */
+#define CONFIG_ARCH_V7 1
+#define CONFIG_ARCH_V7_A 1
+#define CONFIG_ARCH_EXT_SECURITY 1
+#define CONFIG_CPU_CORTEX_A8 1
+#define CONFIG_SOC_TI_OMAP_3 1
+#define CONFIG_SOC_TI_OMAP_35XX 1
+#define CONFIG_SOC_TI_OMAP_3530 1
+#define CONFIG_BOARD_TI_BEAGLE_BOARD 1
+#define CONFIG_GCC 1
+
+#define CONFIG_MEMORY_ALLOCATOR_NAIVE 1
+
+#define CONFIG_DEBUG_GUEST_CONTEXT 0
+#define CONFIG_DEBUG_VP_OMAP_35XX_INTC 0
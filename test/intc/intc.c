@@ -0,0 +1,272 @@
+#include <stdlib.h>
+#include <time.h>
+
+#include "common/debug.h"
+#include "common/stdlib.h"
+
+#include "guestManager/guestContext.h"
+
+#include "vm/types.h"
+#include "vm/omap35xx/hardwareLibrary.h"
+#include "vm/omap35xx/intc.h"
+#include "vm/omap35xx/intcInternals.h"
+
+
+/*
+ * Host test for the priority resolution of the emulated interrupt controller. The controller is
+ * driven through random sequences of interrupts being raised and cleared, mask register stores and
+ * ILR stores; after every step, the active IRQ read from INTCPS_SIR_IRQ is compared with the one
+ * selected by a scan of all pending IRQs. Afterwards both are timed on a set of random
+ * configurations.
+ *
+ * usage: intc [seed]
+ */
+
+
+#define CONFIGURATIONS           1000
+#define STEPS_PER_CONFIGURATION  200
+#define READS_PER_CONFIGURATION  1000
+
+#define NANOSECONDS_PER_MICROSECOND  1000
+
+
+/*
+ * Stand-ins for the parts of the hypervisor that are not linked into the test.
+ */
+
+const char *const ERROR_BAD_ACCESS_SIZE = "bad access size";
+const char *const ERROR_BAD_ARGUMENTS = "bad arguments";
+const char *const ERROR_NO_SUCH_REGISTER = "no such register";
+const char *const ERROR_NOT_IMPLEMENTED = "not implemented";
+const char *const ERROR_UNPREDICTABLE_INSTRUCTION = "unpredictable instruction";
+
+void dieNow(const char *file, u32int line, const char *caller, const char *message)
+{
+  printf("%s:%u: %s: %s" EOL, file, line, caller, message);
+  exit(1);
+}
+
+/*
+ * The allocator macros of common/stdlib.h map onto the C library; the parentheses keep the names
+ * from being expanded again.
+ */
+void *uncheckedMalloc(u32int size)
+{
+  return (malloc)(size);
+}
+
+void uncheckedFree(void *ptr)
+{
+  (free)(ptr);
+}
+
+void maskInterruptBE(u32int irqNum)
+{
+  UNUSED(irqNum);
+}
+
+void unmaskInterruptBE(u32int irqNum)
+{
+  UNUSED(irqNum);
+}
+
+
+/*
+ * The test itself.
+ */
+
+static device intcDevice = { .deviceName = "INTC" };
+
+static u64int getTime(void)
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (u64int)time.tv_sec * 1000000000ULL + time.tv_nsec;
+}
+
+static u32int randomWord(void)
+{
+  return ((u32int)rand() << 16) ^ (u32int)rand();
+}
+
+static u32int loadRegister(GCONTXT *context, u32int regOffset)
+{
+  return loadIntc(context, &intcDevice, WORD, INTERRUPT_CONTROLLER + regOffset,
+      INTERRUPT_CONTROLLER + regOffset);
+}
+
+static void storeRegister(GCONTXT *context, u32int regOffset, u32int value)
+{
+  storeIntc(context, &intcDevice, WORD, INTERRUPT_CONTROLLER + regOffset,
+      INTERRUPT_CONTROLLER + regOffset, value);
+}
+
+/*
+ * Reference: looks at every pending IRQ and keeps the last one with the lowest priority value,
+ * which is the highest priority.
+ */
+static u32int scanPendingIrqs(struct InterruptController *irqController)
+{
+  const u32int pending[INTCPS_NR_OF_BANKS] =
+  {
+    irqController->intcPendingIrq0, irqController->intcPendingIrq1, irqController->intcPendingIrq2
+  };
+  u32int currentHighestPriority = INTCPS_NR_OF_PRIORITIES;
+  u32int currentIrqNumber = 0;
+  u32int i;
+  for (i = 0; i < INTCPS_NR_OF_INTERRUPTS; i++)
+  {
+    if (pending[i / INTCPS_INTERRUPTS_PER_BANK] & (1 << (i % INTCPS_INTERRUPTS_PER_BANK)))
+    {
+      u32int priority = irqController->intcIlr[i] >> INTCPS_ILR_PRIORITY_SHIFT;
+      if (priority <= currentHighestPriority)
+      {
+        currentHighestPriority = priority;
+        currentIrqNumber = i;
+      }
+    }
+  }
+  return currentIrqNumber;
+}
+
+/*
+ * Resets the controller and sets random priorities, with only a few distinct levels so that ties
+ * between pending IRQs are common.
+ */
+static void randomConfiguration(GCONTXT *context)
+{
+  const u32int levels = 1 + rand() % 8;
+  const u32int firstLevel = rand() % (INTCPS_NR_OF_PRIORITIES - levels + 1);
+  u32int i;
+
+  storeRegister(context, REG_INTCPS_SYSCONFIG, INTCPS_SYSCONFIG_SOFTRESET);
+  for (i = 0; i < INTCPS_NR_OF_INTERRUPTS; i++)
+  {
+    // the FIQ steering and reserved bits are random too; they must not affect the priority.
+    const u32int level = firstLevel + rand() % levels;
+    storeRegister(context, REG_INTCPS_ILR0 + 4 * i,
+        (level << INTCPS_ILR_PRIORITY_SHIFT) | (randomWord() & ~INTCPS_ILR_RESERVED));
+  }
+  for (i = 0; i < INTCPS_NR_OF_INTERRUPTS; i++)
+  {
+    if (rand() % 2)
+    {
+      setInterrupt(context, i);
+    }
+  }
+}
+
+static void randomStep(GCONTXT *context)
+{
+  static const u32int maskSetRegisters[INTCPS_NR_OF_BANKS] =
+  {
+    REG_INTCPS_MIR_SET0, REG_INTCPS_MIR_SET1, REG_INTCPS_MIR_SET2
+  };
+  static const u32int maskClearRegisters[INTCPS_NR_OF_BANKS] =
+  {
+    REG_INTCPS_MIR_CLEAR0, REG_INTCPS_MIR_CLEAR1, REG_INTCPS_MIR_CLEAR2
+  };
+  const u32int irqNumber = rand() % INTCPS_NR_OF_INTERRUPTS;
+  const u32int bank = rand() % INTCPS_NR_OF_BANKS;
+
+  switch (rand() % 8)
+  {
+    case 0:
+    case 1:
+    case 2:
+      setInterrupt(context, irqNumber);
+      break;
+    case 3:
+    case 4:
+      clearInterrupt(context, irqNumber);
+      break;
+    case 5:
+      storeRegister(context, maskSetRegisters[bank], randomWord() & randomWord());
+      break;
+    case 6:
+      storeRegister(context, maskClearRegisters[bank], randomWord());
+      break;
+    case 7:
+      storeRegister(context, REG_INTCPS_ILR0 + 4 * irqNumber,
+          (rand() % INTCPS_NR_OF_PRIORITIES) << INTCPS_ILR_PRIORITY_SHIFT);
+      break;
+  }
+}
+
+static u32int checkConfiguration(GCONTXT *context, u32int configuration)
+{
+  struct InterruptController *irqController = context->vm.irqController;
+  u32int failures = 0;
+  u32int step;
+  for (step = 0; step < STEPS_PER_CONFIGURATION; step++)
+  {
+    const u32int expected = scanPendingIrqs(irqController);
+    const u32int actual = loadRegister(context, REG_INTCPS_SIR_IRQ);
+    if (actual != expected)
+    {
+      printf("configuration %u step %u: active IRQ %u, expected %u" EOL, configuration, step,
+          actual, expected);
+      failures++;
+    }
+    randomStep(context);
+  }
+  return failures;
+}
+
+static void timeConfiguration(GCONTXT *context, u64int *scanTime, u64int *lookupTime)
+{
+  struct InterruptController *irqController = context->vm.irqController;
+  volatile u32int sink = 0;
+  u64int start;
+  u32int i;
+
+  start = getTime();
+  for (i = 0; i < READS_PER_CONFIGURATION; i++)
+  {
+    sink += scanPendingIrqs(irqController);
+  }
+  *scanTime += getTime() - start;
+
+  start = getTime();
+  for (i = 0; i < READS_PER_CONFIGURATION; i++)
+  {
+    sink += loadRegister(context, REG_INTCPS_SIR_IRQ);
+  }
+  *lookupTime += getTime() - start;
+}
+
+int main(int argc, char *argv[])
+{
+  const u32int seed = argc > 1 ? strtoul(argv[1], NULL, 0) : (u32int)time(NULL);
+  printf("seed: %u" EOL, seed);
+  srand(seed);
+
+  GCONTXT *context = calloc(1, sizeof(GCONTXT));
+  if (context == NULL)
+  {
+    DIE_NOW(NULL, "out of memory");
+  }
+  initIntc(&context->vm);
+
+  u32int failures = 0;
+  u32int i;
+  for (i = 0; i < CONFIGURATIONS; i++)
+  {
+    randomConfiguration(context);
+    failures += checkConfiguration(context, i);
+  }
+  printf("checked %u configurations, %u failures" EOL, CONFIGURATIONS, failures);
+
+  u64int scanTime = 0, lookupTime = 0;
+  for (i = 0; i < CONFIGURATIONS; i++)
+  {
+    randomConfiguration(context);
+    timeConfiguration(context, &scanTime, &lookupTime);
+  }
+  printf("scan of pending IRQs:  %u us for %u reads" EOL,
+      (u32int)(scanTime / NANOSECONDS_PER_MICROSECOND), CONFIGURATIONS * READS_PER_CONFIGURATION);
+  printf("INTCPS_SIR_IRQ load:   %u us for %u reads" EOL,
+      (u32int)(lookupTime / NANOSECONDS_PER_MICROSECOND), CONFIGURATIONS * READS_PER_CONFIGURATION);
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+/*
+ * Configuration for the host build of the translation pipeline. This takes the place of the
+ * header generated by kconfig; only symbols used by the sources linked into the benchmark are set.
+ * The decoder is selected in the Makefile.
+ */
+#define CONFIG_ARCH_V7 1
+#define CONFIG_ARCH_V7_A 1
+#define CONFIG_ARCH_EXT_SECURITY 1
+#define CONFIG_CPU_CORTEX_A8 1
+#define CONFIG_SOC_TI_OMAP_3 1
+#define CONFIG_SOC_TI_OMAP_35XX 1
+#define CONFIG_SOC_TI_OMAP_3530 1
+#define CONFIG_BOARD_TI_BEAGLE_BOARD 1
+#define CONFIG_GCC 1
+
+#define CONFIG_INDIRECT_BRANCH_CACHE 1
+#define CONFIG_BLOCK_STORE_STATISTICS 1
+#define CONFIG_MEMORY_ALLOCATOR_NAIVE 1
+
+#define CONFIG_DEBUG_BLOCK_STORE 0
+#define CONFIG_DEBUG_DECODER 0
+#define CONFIG_DEBUG_GUEST_CONTEXT 0
+#define CONFIG_DEBUG_LINKER 0
+#define CONFIG_DEBUG_SCANNER 0
+#define CONFIG_DEBUG_SCANNER_BLOCK_TRACE 0
+#define CONFIG_DEBUG_SCANNER_MARK 0
+#define CONFIG_DEBUG_TRANSLATION 0
+#define CONFIG_DEBUG_TRANSLATION_STORE 0
@@ -0,0 +1,483 @@
+#include <fcntl.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/debug.h"
+#include "common/stdlib.h"
+
+#include "cpuArch/constants.h"
+
+#include "guestManager/basicBlockStore.h"
+#include "guestManager/guestContext.h"
+#include "guestManager/translationStore.h"
+
+#include "instructionEmu/decoder.h"
+#include "instructionEmu/interpreter.h"
+#include "instructionEmu/scanner.h"
+
+#include "memoryManager/memoryProtection.h"
+#include "memoryManager/mmu.h"
+
+
+/*
+ * Host benchmark for the translation pipeline: the scanner, the ARM decoder, the PC handlers and
+ * block copy routines, and the translation and block stores. These are built for the host and
+ * linked against the stubs below instead of the rest of the hypervisor.
+ *
+ * The guest image (typically the text section of a kernel, extracted with objcopy -O binary -j
+ * .text) is mapped at its guest virtual address if one is given, so that guest addresses, and
+ * hence block store hashing and translated PC constants, are the same as on the board. The image
+ * is then scanned block by block from start to end: each block starts at the word after the end
+ * of the previous one. Afterwards every block is looked up once more to measure the block store.
+ *
+ * usage: translation [-r runs] image [load address]
+ */
+
+
+#if defined(CONFIG_DECODER_TABLE_LOOKUP)
+#define DECODER_NAME  "table lookup"
+#elif defined(CONFIG_DECODER_TABLE_SEARCH)
+#define DECODER_NAME  "table search"
+#else
+#error "unsupported decoder for the translation benchmark"
+#endif
+
+/*
+ * Size of the executable pool for translated code, as in scripts/omap3530.lds.
+ */
+#define CODE_CACHE_POOL_SIZE  0x00200000
+
+#define NANOSECONDS_PER_SECOND  1000000000.0
+
+
+struct benchmarkRun
+{
+  u32int blocks;
+  u32int instructions;
+  u32int skippedWords;
+  u32int codeWords;
+  u32int pcMapWords;
+  u32int evictions;
+  u32int blocksRetired;
+  u64int scanTime;
+  u32int lookupHits;
+  u32int lookupMisses;
+  u32int lookupProbes;
+  u64int lookupTime;
+};
+
+
+static jmp_buf *dieHandler;
+static u32int *blockStarts;
+
+
+/*
+ * Stand-ins for the parts of the hypervisor that are not linked into the benchmark.
+ */
+
+__asm__(".bss\n"
+        ".balign 4096\n"
+        ".globl __RAM_CODE_CACHE_POOL_BEGIN__\n"
+        "__RAM_CODE_CACHE_POOL_BEGIN__:\n"
+        ".space " EXPAND_TO_STRING(CODE_CACHE_POOL_SIZE) "\n"
+        ".globl __RAM_CODE_CACHE_POOL_END__\n"
+        "__RAM_CODE_CACHE_POOL_END__:\n"
+        ".previous\n");
+
+GCONTXT *volatile activeGuestContext;
+
+const char *const ERROR_BAD_ACCESS_SIZE = "bad access size";
+const char *const ERROR_BAD_ARGUMENTS = "bad arguments";
+const char *const ERROR_NO_SUCH_REGISTER = "no such register";
+const char *const ERROR_NOT_IMPLEMENTED = "not implemented";
+const char *const ERROR_UNPREDICTABLE_INSTRUCTION = "unpredictable instruction";
+
+void dieNow(const char *file, u32int line, const char *caller, const char *message)
+{
+  if (dieHandler != NULL)
+  {
+    longjmp(*dieHandler, 1);
+  }
+  printf("%s:%u: %s: %s" EOL, file, line, caller, message);
+  exit(1);
+}
+
+void dieNow2(const char *file, u32int line, const char *caller, const char *message1,
+             const char *message2)
+{
+  if (dieHandler != NULL)
+  {
+    longjmp(*dieHandler, 1);
+  }
+  printf("%s:%u: %s: %s%s" EOL, file, line, caller, message1, message2);
+  exit(1);
+}
+
+/*
+ * The allocator macros of common/stdlib.h map onto the C library; the parentheses keep the names
+ * from being expanded again.
+ */
+void *uncheckedMalloc(u32int size)
+{
+  return (malloc)(size);
+}
+
+void uncheckedFree(void *ptr)
+{
+  (free)(ptr);
+}
+
+void guestWriteProtect(GCONTXT *gc, u32int startAddress, u32int endAddress)
+{
+  UNUSED(gc);
+  UNUSED(startAddress);
+  UNUSED(endAddress);
+}
+
+void mmuCleanDCacheByMVAtoPOU(u32int mva)
+{
+  UNUSED(mva);
+}
+
+void mmuInvIcacheByMVAtoPOU(u32int mva)
+{
+  UNUSED(mva);
+}
+
+void mmuUnifyCaches(u32int start, u32int size)
+{
+  UNUSED(start);
+  UNUSED(size);
+}
+
+/*
+ * The decoding tables refer to the interpreter, which is never called from the scanner. This list
+ * holds every handler named in instructionEmu/decoder/arm/tables.inc.c.
+ */
+#define INTERPRETER_STUB(name)                                                                     \
+  u32int name(GCONTXT *context, Instruction instr)                                                 \
+  {                                                                                                \
+    UNUSED(context);                                                                               \
+    UNUSED(instr);                                                                                 \
+    DIE_NOW(context, #name " is not linked into the benchmark");                                   \
+  }
+
+INTERPRETER_STUB(armAluImmInstruction)
+INTERPRETER_STUB(armAluRegInstruction)
+INTERPRETER_STUB(armBInstruction)
+INTERPRETER_STUB(armBkptInstruction)
+INTERPRETER_STUB(armBlInstruction)
+INTERPRETER_STUB(armBlxImmediateInstruction)
+INTERPRETER_STUB(armBlxRegisterInstruction)
+INTERPRETER_STUB(armBxInstruction)
+INTERPRETER_STUB(armBxjInstruction)
+INTERPRETER_STUB(armCpsInstruction)
+INTERPRETER_STUB(armDbgInstruction)
+INTERPRETER_STUB(armLdmExcRetInstruction)
+INTERPRETER_STUB(armLdmInstruction)
+INTERPRETER_STUB(armLdmUserInstruction)
+INTERPRETER_STUB(armLdrImmInstruction)
+INTERPRETER_STUB(armLdrRegInstruction)
+INTERPRETER_STUB(armLdrbImmInstruction)
+INTERPRETER_STUB(armLdrbRegInstruction)
+INTERPRETER_STUB(armLdrbtImmInstruction)
+INTERPRETER_STUB(armLdrbtRegInstruction)
+INTERPRETER_STUB(armLdrdImmInstruction)
+INTERPRETER_STUB(armLdrdRegInstruction)
+INTERPRETER_STUB(armLdrhImmInstruction)
+INTERPRETER_STUB(armLdrhRegInstruction)
+INTERPRETER_STUB(armLdrhtImmInstruction)
+INTERPRETER_STUB(armLdrhtRegInstruction)
+INTERPRETER_STUB(armLdrtImmInstruction)
+INTERPRETER_STUB(armLdrtRegInstruction)
+INTERPRETER_STUB(armMcrInstruction)
+INTERPRETER_STUB(armMrcInstruction)
+INTERPRETER_STUB(armMrsInstruction)
+INTERPRETER_STUB(armMsrImmInstruction)
+INTERPRETER_STUB(armMsrRegInstruction)
+INTERPRETER_STUB(armRfeInstruction)
+INTERPRETER_STUB(armSetendInstruction)
+INTERPRETER_STUB(armSevInstruction)
+INTERPRETER_STUB(armSmcInstruction)
+INTERPRETER_STUB(armSrsInstruction)
+INTERPRETER_STUB(armStmInstruction)
+INTERPRETER_STUB(armStmUserInstruction)
+INTERPRETER_STUB(armStrImmInstruction)
+INTERPRETER_STUB(armStrRegInstruction)
+INTERPRETER_STUB(armStrbImmInstruction)
+INTERPRETER_STUB(armStrbRegInstruction)
+INTERPRETER_STUB(armStrbtImmInstruction)
+INTERPRETER_STUB(armStrbtRegInstruction)
+INTERPRETER_STUB(armStrdImmInstruction)
+INTERPRETER_STUB(armStrdRegInstruction)
+INTERPRETER_STUB(armStrhImmInstruction)
+INTERPRETER_STUB(armStrhRegInstruction)
+INTERPRETER_STUB(armStrhtImmInstruction)
+INTERPRETER_STUB(armStrhtRegInstruction)
+INTERPRETER_STUB(armStrtImmInstruction)
+INTERPRETER_STUB(armStrtRegInstruction)
+INTERPRETER_STUB(armSwpInstruction)
+INTERPRETER_STUB(armWfeInstruction)
+INTERPRETER_STUB(armWfiInstruction)
+INTERPRETER_STUB(svcInstruction)
+INTERPRETER_STUB(undefinedInstruction)
+
+
+/*
+ * The benchmark itself.
+ */
+
+static u64int getTime(void)
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (u64int)time.tv_sec * 1000000000ULL + time.tv_nsec;
+}
+
+static u32int perSecond(u32int count, u64int time)
+{
+  return time == 0 ? 0 : (u32int)(count * NANOSECONDS_PER_SECOND / time);
+}
+
+static void printFraction(u32int numerator, u32int denominator)
+{
+  u32int thousandths = denominator == 0 ? 0 : (u32int)((u64int)numerator * 1000 / denominator);
+  printf("%u.%.3u", thousandths / 1000, thousandths % 1000);
+}
+
+/*
+ * Maps the image with a terminating hypercall after its last word, so that the last block ends
+ * within the image. Returns the guest address of the image.
+ */
+static u32int loadImage(const char *fileName, u32int loadAddress, u32int *size)
+{
+  int file = open(fileName, O_RDONLY);
+  struct stat status;
+  if (file < 0 || fstat(file, &status) != 0)
+  {
+    printf("cannot open %s" EOL, fileName);
+    exit(1);
+  }
+  *size = status.st_size & ~(ARM_INSTRUCTION_SIZE - 1);
+
+  const u32int pageSize = sysconf(_SC_PAGESIZE);
+  const u32int pageOffset = loadAddress & (pageSize - 1);
+  const u32int mapSize = pageOffset + *size + ARM_INSTRUCTION_SIZE;
+  u8int *map = mmap((void *)(loadAddress - pageOffset), mapSize, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (map == MAP_FAILED || (loadAddress != 0 && (u32int)map != loadAddress - pageOffset))
+  {
+    printf("cannot map %#x bytes at %#.8x" EOL, mapSize, loadAddress);
+    exit(1);
+  }
+
+  u32int *image = (u32int *)(map + pageOffset);
+  u32int done = 0;
+  while (done < *size)
+  {
+    ssize_t count = read(file, (u8int *)image + done, *size - done);
+    if (count <= 0)
+    {
+      printf("cannot read %s" EOL, fileName);
+      exit(1);
+    }
+    done += count;
+  }
+  close(file);
+
+  image[*size / ARM_INSTRUCTION_SIZE] = INSTR_SWI;
+  return (u32int)image;
+}
+
+static GCONTXT *createBenchmarkContext(void)
+{
+  GCONTXT *context = calloc(1, sizeof(GCONTXT));
+  if (context == NULL)
+  {
+    DIE_NOW(NULL, "out of memory");
+  }
+  context->translationStore = malloc(sizeof(TranslationStore));
+  context->execBitmap = calloc(1, SIZE_BITMAP1);
+  if (context->translationStore == NULL || context->execBitmap == NULL)
+  {
+    DIE_NOW(context, "out of memory");
+  }
+  initialiseTranslationStore(context->translationStore);
+  // kernel text runs with the MMU on; translate indirect branches as the hypervisor would then.
+  context->virtAddrEnabled = TRUE;
+  activeGuestContext = context;
+  return context;
+}
+
+static void resetStatistics(TranslationStore *ts)
+{
+  ts->lookupHits = 0;
+  ts->lookupMisses = 0;
+  ts->lookupProbes = 0;
+  ts->lookupMaxProbes = 0;
+  ts->evictions = 0;
+  ts->segmentsRetired = 0;
+  ts->blocksRetired = 0;
+}
+
+/*
+ * Scans the image block by block. A block that makes the hypervisor give up (typically because a
+ * literal pool is scanned as code) is dropped, and scanning resumes at the next word.
+ */
+static void scanImage(GCONTXT *context, u32int start, u32int end, struct benchmarkRun *run)
+{
+  TranslationStore *ts = context->translationStore;
+  jmp_buf handler;
+  volatile u32int address = start;
+
+  dieHandler = &handler;
+  while (address < end)
+  {
+    if (setjmp(handler) != 0)
+    {
+      BlockInfo blockInfo = getBlockInfo(ts, address);
+      if (blockInfo.blockFound)
+      {
+        invalidateBlock(blockInfo.blockPtr);
+      }
+      run->skippedWords++;
+      address += ARM_INSTRUCTION_SIZE;
+      continue;
+    }
+
+    BasicBlock *block = scanBlock(context, address);
+    blockStarts[run->blocks++] = address;
+    run->instructions += block->guestEnd - block->guestStart + 1;
+    run->codeWords += block->codeStoreSize;
+    if (block->pcMapSize != PC_MAP_NONE)
+    {
+      run->pcMapWords += block->pcMapSize;
+    }
+    address = (u32int)(block->guestEnd + 1);
+  }
+  dieHandler = NULL;
+}
+
+/*
+ * Looks up every block that was scanned. Blocks that have been evicted or retired since show up as misses.
+ */
+static void lookUpBlocks(TranslationStore *ts, struct benchmarkRun *run)
+{
+  u32int i;
+  for (i = 0; i < run->blocks; i++)
+  {
+    getBlockInfo(ts, blockStarts[i]);
+  }
+}
+
+static void runBenchmark(GCONTXT *context, u32int start, u32int end, struct benchmarkRun *run)
+{
+  TranslationStore *ts = context->translationStore;
+  u64int time;
+
+  clearTranslationsAll(ts);
+  resetStatistics(ts);
+  memset(run, 0, sizeof(struct benchmarkRun));
+
+  time = getTime();
+  scanImage(context, start, end, run);
+  run->scanTime = getTime() - time;
+  run->evictions = ts->evictions;
+  run->blocksRetired = ts->blocksRetired;
+
+  resetStatistics(ts);
+  time = getTime();
+  lookUpBlocks(ts, run);
+  run->lookupTime = getTime() - time;
+
+  run->lookupHits = ts->lookupHits;
+  run->lookupMisses = ts->lookupMisses;
+  run->lookupProbes = ts->lookupProbes;
+}
+
+static void printResults(const struct benchmarkRun *run, u32int runs)
+{
+  const u32int hitProbes = run->lookupProbes - run->lookupMisses * BASIC_BLOCK_STORE_PROBE_LIMIT;
+
+  printf("decoder:               %s" EOL, DECODER_NAME);
+  printf("best of:               %u runs" EOL, runs);
+  printf("blocks:                %u (%u words skipped)" EOL, run->blocks, run->skippedWords);
+  printf("instructions:          %u" EOL, run->instructions);
+  printf("blocks/s:              %u" EOL, perSecond(run->blocks, run->scanTime));
+  printf("instructions/s:        %u" EOL, perSecond(run->instructions, run->scanTime));
+  printf("code bytes/guest byte: ");
+  printFraction(run->codeWords, run->instructions);
+  printf(" (");
+  printFraction(run->codeWords + run->pcMapWords, run->instructions);
+  printf(" with PC maps)" EOL);
+  printf("blocks evicted:        %u (%u retired with code store segments)" EOL, run->evictions,
+         run->blocksRetired);
+  printf("lookups/s:             %u" EOL, perSecond(run->blocks, run->lookupTime));
+  printf("lookup hits:           %u (%u misses)" EOL, run->lookupHits, run->lookupMisses);
+  printf("probes per hit:        ");
+  printFraction(hitProbes, run->lookupHits);
+  printf(EOL);
+}
+
+static void usage(const char *program)
+{
+  printf("usage: %s [-r runs] image [load address]" EOL, program);
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  u32int runs = 1;
+  int argument = 1;
+  if (argument + 1 < argc && strcmp(argv[argument], "-r") == 0)
+  {
+    runs = strtoul(argv[argument + 1], NULL, 0);
+    argument += 2;
+  }
+  if (argument >= argc || argc - argument > 2 || runs == 0)
+  {
+    usage(argv[0]);
+  }
+  const char *fileName = argv[argument];
+  const u32int loadAddress = argument + 1 < argc ? strtoul(argv[argument + 1], NULL, 0) : 0;
+
+  u32int size;
+  const u32int start = loadImage(fileName, loadAddress, &size);
+  printf("image:                 %s, %#x bytes @ %#.8x" EOL, fileName, size, start);
+
+  blockStarts = malloc(size + ARM_INSTRUCTION_SIZE);
+  if (blockStarts == NULL)
+  {
+    DIE_NOW(NULL, "out of memory");
+  }
+
+  initDecoder();
+  GCONTXT *context = createBenchmarkContext();
+
+  // every run does the same work; only the times differ.
+  struct benchmarkRun run;
+  u64int bestScanTime = 0, bestLookupTime = 0;
+  u32int i;
+  for (i = 0; i < runs; i++)
+  {
+    runBenchmark(context, start, start + size, &run);
+    if (i == 0 || run.scanTime < bestScanTime)
+    {
+      bestScanTime = run.scanTime;
+    }
+    if (i == 0 || run.lookupTime < bestLookupTime)
+    {
+      bestLookupTime = run.lookupTime;
+    }
+  }
+  run.scanTime = bestScanTime;
+  run.lookupTime = bestLookupTime;
+
+  printResults(&run, runs);
+  dumpBlockStoreStats(context);
+  return 0;
+}